@@ -22,6 +22,8 @@ void setup() {
     console_println("06.SAM");
     console_println("------");
 
+    sam_left.set_sample_rate(48000);
+    sam_right.set_sample_rate(48000);
     sam_right.set_speed(120);
     sam_right.set_throat(100);
 
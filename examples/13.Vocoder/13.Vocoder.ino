@@ -26,6 +26,7 @@ void setup() {
     console_println("13.Vocoder");
     console_println("----------");
 
+    sam.set_sample_rate(48000);
     sam.speak("hello world");
 
     wavetable.set_waveform(KlangWellen::WAVEFORM_SAWTOOTH);
@@ -0,0 +1,58 @@
+#include "Arduino.h"
+#include "System.h"
+#include "Console.h"
+#include "AudioDevice.h"
+#include "Beat.h"
+
+#include "Note.h"
+#include "SamplerVoicePool.h"
+
+using namespace klangwellen;
+
+static constexpr int32_t SAMPLE_LENGTH = 12000;
+float                    sample_buffer[SAMPLE_LENGTH];
+SamplerVoicePool<4>      sampler_pool(sample_buffer, SAMPLE_LENGTH, 48000);
+Beat                     beat_timer;
+
+const uint8_t chord[] = {Note::C_4, Note::E_4, Note::G_4, Note::B_4, Note::D_5};
+
+void setup() {
+    system_init();
+    system_init_audiocodec();
+
+    console_println("-------------------");
+    console_println("20.SamplerVoicePool");
+    console_println("-------------------");
+
+    /* fill sample buffer with a decaying sawtooth tuned to middle C */
+    const float period = 48000.0f / KlangWellen::midi_note_to_frequency(Note::C_4);
+    for (int32_t i = 0; i < SAMPLE_LENGTH; i++) {
+        const float ratio = 1.0f - (float) i / SAMPLE_LENGTH;
+        const float phase = KlangWellen::mod(i, period) / period;
+        sample_buffer[i]  = (phase * 2.0f - 1.0f) * 0.2f * ratio;
+    }
+
+    sampler_pool.set_root_note(Note::C_4);
+    sampler_pool.set_voice_stealing(KlangWellen::VOICE_STEALING_OLDEST);
+    sampler_pool.interpolate_samples(true);
+
+    beat_timer.init();
+    beat_timer.set_bpm(120 * 2);
+    beat_timer.start();
+}
+
+void loop() {}
+
+void beat_event(const uint8_t beat_id, const uint16_t beat_counter) {
+    /* five notes on four voices: the oldest voice is stolen */
+    const uint8_t note = chord[beat_counter % 5];
+    const int8_t  voice = sampler_pool.note_on(note, 100);
+    console_println("note: %i voice: %i active voices: %i", note, voice, sampler_pool.get_number_of_active_voices());
+}
+
+void audioblock(const AudioBlock* audio_block) {
+    sampler_pool.process(audio_block->output[0], audio_block->block_size);
+    if (audio_block->output_channels == 2) {
+        KlangWellen::copy(audio_block->output[0], audio_block->output[1], audio_block->block_size);
+    }
+}
@@ -29,8 +29,14 @@
 
 #pragma once
 
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+
 #include "KlangWellen.h"
 #include "AudioSignal.h"
+#include "ScheduledEvent.h"
 
 namespace klangwellen {
     class ADSR {
@@ -84,20 +90,101 @@ namespace klangwellen {
         void process(float*         signal_buffer_left,
                      float*         signal_buffer_right,
                      const uint32_t buffer_length) {
-            for (uint32_t i = 0; i < buffer_length; i++) {
-                step();
-                signal_buffer_left[i] *= _amplitude;
-                signal_buffer_right[i] *= _amplitude;
+            float mEnvelope[RENDER_CHUNK_SIZE];
+            for (uint32_t i = 0; i < buffer_length; i += RENDER_CHUNK_SIZE) {
+                const uint32_t mLength = std::min(RENDER_CHUNK_SIZE, buffer_length - i);
+                render(mEnvelope, mLength);
+                for (uint32_t j = 0; j < mLength; j++) {
+                    signal_buffer_left[i + j] *= mEnvelope[j];
+                    signal_buffer_right[i + j] *= mEnvelope[j];
+                }
             }
         }
 
         void process(float* signal_buffer, const uint32_t buffer_length) {
-            for (uint32_t i = 0; i < buffer_length; i++) {
-                step();
-                signal_buffer[i] *= _amplitude;
+            float mEnvelope[RENDER_CHUNK_SIZE];
+            for (uint32_t i = 0; i < buffer_length; i += RENDER_CHUNK_SIZE) {
+                const uint32_t mLength = std::min(RENDER_CHUNK_SIZE, buffer_length - i);
+                render(mEnvelope, mLength);
+                for (uint32_t j = 0; j < mLength; j++) {
+                    signal_buffer[i + j] *= mEnvelope[j];
+                }
             }
         }
 
+        /**
+         * writes the envelope into a buffer instead of applying it to a signal. the block is split into segments at
+         * stage boundaries, states are only evaluated once per segment.
+         *
+         * @param envelope_buffer receives the amplitude of the envelope for each sample
+         */
+        void render(float* envelope_buffer, const uint32_t buffer_length) {
+            uint32_t mOffset = 0;
+            while (mOffset < buffer_length) {
+                if (_state == ENVELOPE_STATE::IDLE || _state == ENVELOPE_STATE::SUSTAIN) {
+                    std::fill_n(envelope_buffer + mOffset, buffer_length - mOffset, _amplitude);
+                    return;
+                }
+                /* ramp up to the sample before the stage boundary, the boundary itself is handled by `step()` */
+                const uint32_t mRamp = std::min(samples_to_stage_boundary() - 1, buffer_length - mOffset);
+                if (mRamp > 0) {
+                    mOffset += render_ramp(envelope_buffer + mOffset, mRamp);
+                }
+                if (mOffset < buffer_length) {
+                    step();
+                    envelope_buffer[mOffset] = _amplitude;
+                    mOffset++;
+                }
+            }
+        }
+
+        /**
+         * applies the envelope to a signal and starts or stops it sample-accurately at the offsets of the scheduled
+         * events ( `KlangWellen::EVENT_NOTE_ON` starts, `KlangWellen::EVENT_NOTE_OFF` stops the envelope ).
+         *
+         * @param events           events sorted by offset
+         * @param number_of_events number of events
+         * @return number of applied events ( see `process_scheduled_events()` )
+         */
+        uint32_t process(float*                signal_buffer,
+                         const uint32_t        buffer_length,
+                         const ScheduledEvent* events,
+                         const uint32_t        number_of_events) {
+            return process_scheduled_events(
+                buffer_length, events, number_of_events,
+                [&](const uint32_t offset, const uint32_t length) { process(signal_buffer + offset, length); },
+                [&](const ScheduledEvent& event) { apply_event(event); });
+        }
+
+        uint32_t process(float*                signal_buffer_left,
+                         float*                signal_buffer_right,
+                         const uint32_t        buffer_length,
+                         const ScheduledEvent* events,
+                         const uint32_t        number_of_events) {
+            return process_scheduled_events(
+                buffer_length, events, number_of_events,
+                [&](const uint32_t offset, const uint32_t length) {
+                    process(signal_buffer_left + offset, signal_buffer_right + offset, length);
+                },
+                [&](const ScheduledEvent& event) { apply_event(event); });
+        }
+
+        /**
+         * writes the envelope into a buffer and starts or stops it sample-accurately at the offsets of the scheduled
+         * events.
+         *
+         * @return number of applied events
+         */
+        uint32_t render(float*                envelope_buffer,
+                        const uint32_t        buffer_length,
+                        const ScheduledEvent* events,
+                        const uint32_t        number_of_events) {
+            return process_scheduled_events(
+                buffer_length, events, number_of_events,
+                [&](const uint32_t offset, const uint32_t length) { render(envelope_buffer + offset, length); },
+                [&](const ScheduledEvent& event) { apply_event(event); });
+        }
+
         void start() {
             check_scheduled_attack_state();
         }
@@ -106,12 +193,27 @@ namespace klangwellen {
             check_scheduled_release_state();
         }
 
+        /**
+         * @return true if the envelope is not running i.e it has not been started or its release stage has ended
+         */
+        bool is_idle() const {
+            return _state == ENVELOPE_STATE::IDLE;
+        }
+
+        /**
+         * @return current amplitude of the envelope
+         */
+        float get_amplitude() const {
+            return _amplitude;
+        }
+
         float get_attack() const {
             return _attack;
         }
 
         void set_attack(float pAttack) {
             _attack = pAttack;
+            update_attack_coefficients();
         }
 
         void set_adsr(float pAttack, float pDecay, float pSustain, float pRelease) {
@@ -127,6 +229,7 @@ namespace klangwellen {
 
         void set_decay(float pDecay) {
             _decay = pDecay;
+            update_decay_coefficients();
         }
 
         float get_sustain() const {
@@ -135,15 +238,110 @@ namespace klangwellen {
 
         void set_sustain(float pSustain) {
             _sustain = pSustain;
+            update_decay_coefficients();
+            update_release_coefficients();
         }
 
-        float get_release() const;
+        float get_release() const {
+            return _release;
+        }
 
         void set_release(float pRelease) {
             _release = pRelease;
+            update_release_coefficients();
+        }
+
+        /**
+         * sets the curvature of attack, decay and release stage.
+         *
+         * @param pCurve 0.0 for linear stages ( default ) up to 1.0 for strongly exponential stages
+         */
+        void set_curve(const float pCurve) {
+            set_attack_curve(pCurve);
+            set_decay_curve(pCurve);
+            set_release_curve(pCurve);
+        }
+
+        /**
+         * sets the curvature of the attack stage. curved stages are computed as one multiply-add per sample (
+         * i.e <code>amplitude = amplitude * coefficient + offset</code> ) with coefficients that are precomputed when
+         * the stage parameters change.
+         * <p>
+         * the attack rises quickly and approaches full amplitude slowly, like an analog envelope charging a capacitor.
+         *
+         * @param pCurve 0.0 for a linear stage ( default ) up to 1.0 for a strongly exponential stage
+         */
+        void set_attack_curve(const float pCurve) {
+            _attack_curve = KlangWellen::clamp(pCurve, 0.0f, 1.0f);
+            update_attack_coefficients();
+        }
+
+        float get_attack_curve() const {
+            return _attack_curve;
+        }
+
+        /**
+         * sets the curvature of the decay stage. the decay falls quickly and approaches the sustain level slowly.
+         *
+         * @param pCurve 0.0 for a linear stage ( default ) up to 1.0 for a strongly exponential stage
+         */
+        void set_decay_curve(const float pCurve) {
+            _decay_curve = KlangWellen::clamp(pCurve, 0.0f, 1.0f);
+            update_decay_coefficients();
+        }
+
+        float get_decay_curve() const {
+            return _decay_curve;
+        }
+
+        /**
+         * sets the curvature of the release stage. a curved release reaches zero in release time when released from the
+         * sustain level.
+         *
+         * @param pCurve 0.0 for a linear stage ( default ) up to 1.0 for a strongly exponential stage
+         */
+        void set_release_curve(const float pCurve) {
+            _release_curve = KlangWellen::clamp(pCurve, 0.0f, 1.0f);
+            update_release_coefficients();
+        }
+
+        float get_release_curve() const {
+            return _release_curve;
+        }
+
+        /**
+         * computes the coefficients of a curve that moves from `from` to `to` in `duration` seconds. the curve
+         * converges exponentially towards a target that overshoots `to` by `ratio` times the range, the ratio is
+         * derived from the curvature ( 1.0 -> 0.0001, approaching 0.0 -> 100, i.e almost linear ). a curvature of 0.0
+         * yields a coefficient of 1.0 and a delta of 0.0.
+         */
+        static void compute_curve_coefficients(const float    from,
+                                               const float    to,
+                                               const float    duration,
+                                               const float    curve,
+                                               const uint32_t sample_rate,
+                                               float&         coefficient,
+                                               float&         delta) {
+            if (curve <= 0.0f) {
+                coefficient = 1.0f;
+                delta       = 0.0f;
+                return;
+            }
+            const float mRange     = std::max(fabsf(to - from), MINIMUM_CURVE_RANGE);
+            const float mDirection = to >= from ? 1.0f : -1.0f;
+            const float mRatio     = powf(10.0f, 2.0f - 6.0f * curve);
+            const float mTarget    = to + mDirection * mRange * mRatio;
+            const float mSamples   = duration * static_cast<float>(sample_rate);
+            coefficient            = mSamples > 0.0f ? expf(-logf((1.0f + mRatio) / mRatio) / mSamples) : 0.0f;
+            delta                  = mTarget * (1.0f - coefficient);
         }
 
     private:
+        static constexpr uint32_t RENDER_CHUNK_SIZE   = 64;
+        static constexpr float    MINIMUM_CURVE_RANGE = 0.001f;
+        /* stages end within this distance of their target, absorbs rounding of accumulated and block rendered ramps */
+        static constexpr float    STAGE_TOLERANCE     = 1.0e-5f;
+
         enum class ENVELOPE_STATE {
             IDLE,
             ATTACK,
@@ -162,31 +360,89 @@ namespace klangwellen {
         float          _release;
         ENVELOPE_STATE _state;
         float          _sustain;
+        /* amplitude is advanced as `_amplitude * _coefficient + _delta`, linear stages use a coefficient of 1 */
+        float          _coefficient         = 1.0f;
+        float          _attack_curve        = 0.0f;
+        float          _attack_coefficient  = 1.0f;
+        float          _attack_delta        = 0.0f;
+        float          _decay_curve         = 0.0f;
+        float          _decay_coefficient   = 1.0f;
+        float          _decay_delta         = 0.0f;
+        float          _release_curve       = 0.0f;
+        float          _release_coefficient = 1.0f;
+        float          _release_delta       = 0.0f;
+
+        void apply_event(const ScheduledEvent& event) {
+            if (event.type == KlangWellen::EVENT_NOTE_ON) {
+                start();
+            } else if (event.type == KlangWellen::EVENT_NOTE_OFF) {
+                stop();
+            }
+        }
 
         void check_scheduled_attack_state() {
             if (_amplitude > 0.0f) {
                 if (USE_FADE_TO_ZERO_STATE) {
                     if (_state != ENVELOPE_STATE::PRE_ATTACK_FADE_TO_ZERO) {
-                        _delta = compute_delta_fraction(-_amplitude, FADE_TO_ZERO_RATE_SEC);
+                        _coefficient = 1.0f;
+                        _delta       = compute_delta_fraction(-_amplitude, FADE_TO_ZERO_RATE_SEC);
                         setState(ENVELOPE_STATE::PRE_ATTACK_FADE_TO_ZERO);
                     }
                 } else {
-                    _delta = compute_delta_fraction(1.0f, _attack);
-                    setState(ENVELOPE_STATE::ATTACK);
+                    enter_attack_state();
                 }
             } else {
-                _delta = compute_delta_fraction(1.0f, _attack);
-                setState(ENVELOPE_STATE::ATTACK);
+                enter_attack_state();
             }
         }
 
         void check_scheduled_release_state() {
             if (_state != ENVELOPE_STATE::RELEASE) {
-                _delta = compute_delta_fraction(-_amplitude, _release);
+                if (_release_curve > 0.0f) {
+                    _coefficient = _release_coefficient;
+                    _delta       = _release_delta;
+                } else {
+                    _coefficient = 1.0f;
+                    _delta       = compute_delta_fraction(-_amplitude, _release);
+                }
                 setState(ENVELOPE_STATE::RELEASE);
             }
         }
 
+        void enter_attack_state() {
+            if (_attack_curve > 0.0f) {
+                _coefficient = _attack_coefficient;
+                _delta       = _attack_delta;
+            } else {
+                _coefficient = 1.0f;
+                _delta       = compute_delta_fraction(1.0f, _attack);
+            }
+            setState(ENVELOPE_STATE::ATTACK);
+        }
+
+        void enter_decay_state() {
+            if (_decay_curve > 0.0f) {
+                _coefficient = _decay_coefficient;
+                _delta       = _decay_delta;
+            } else {
+                _coefficient = 1.0f;
+                _delta       = compute_delta_fraction(-(1.0f - _sustain), _decay);
+            }
+            setState(ENVELOPE_STATE::DECAY);
+        }
+
+        void update_attack_coefficients() {
+            compute_curve_coefficients(0.0f, 1.0f, _attack, _attack_curve, fSampleRate, _attack_coefficient, _attack_delta);
+        }
+
+        void update_decay_coefficients() {
+            compute_curve_coefficients(1.0f, _sustain, _decay, _decay_curve, fSampleRate, _decay_coefficient, _decay_delta);
+        }
+
+        void update_release_coefficients() {
+            compute_curve_coefficients(_sustain, 0.0f, _release, _release_curve, fSampleRate, _release_coefficient, _release_delta);
+        }
+
         float compute_delta_fraction(float pDelta, float pDuration) const {
             return pDuration > 0 ? (pDelta / static_cast<float>(fSampleRate)) / pDuration : pDelta;
         }
@@ -195,6 +451,67 @@ namespace klangwellen {
             _state = pState;
         }
 
+        /* @return number of rendered samples, curved ramps stop before the sample that ends the stage */
+        uint32_t render_ramp(float* envelope_buffer, const uint32_t length) {
+            if (_coefficient == 1.0f) {
+                for (uint32_t i = 0; i < length; i++) {
+                    envelope_buffer[i] = _amplitude + static_cast<float>(i + 1) * _delta;
+                }
+                _amplitude += _delta * static_cast<float>(length);
+                return length;
+            }
+            /* the estimated boundary of curved ramps can be off by a sample, the crossing is checked explicitly */
+            const float mTarget    = stage_target();
+            const bool  mAscending = _state == ENVELOPE_STATE::ATTACK;
+            float       mAmplitude = _amplitude;
+            uint32_t    i          = 0;
+            for (; i < length; i++) {
+                const float mNext = mAmplitude * _coefficient + _delta;
+                if (mAscending ? mNext >= mTarget : mNext <= mTarget) {
+                    break;
+                }
+                mAmplitude         = mNext;
+                envelope_buffer[i] = mAmplitude;
+            }
+            _amplitude = mAmplitude;
+            return i;
+        }
+
+        /* amplitude at which `step()` ends the current stage */
+        float stage_target() const {
+            switch (_state) {
+                case ENVELOPE_STATE::ATTACK:
+                    return 1.0f - STAGE_TOLERANCE;
+                case ENVELOPE_STATE::DECAY:
+                    return _sustain + STAGE_TOLERANCE;
+                default:
+                    return STAGE_TOLERANCE;
+            }
+        }
+
+        /* number of steps until the current ramp reaches its target ( at least 1 ) */
+        uint32_t samples_to_stage_boundary() const {
+            const float mTarget = stage_target();
+            float       mSteps;
+            if (_coefficient == 1.0f) {
+                if (_delta == 0.0f) {
+                    return 1;
+                }
+                mSteps = (mTarget - _amplitude) / _delta;
+            } else {
+                /* the recurrence converges exponentially towards its asymptote */
+                const float mAsymptote = _delta / (1.0f - _coefficient);
+                mSteps                 = logf((mTarget - mAsymptote) / (_amplitude - mAsymptote)) / logf(_coefficient);
+            }
+            if (!(mSteps > 1.0f)) {
+                return 1;
+            }
+            if (mSteps >= 4.0e9f) {
+                return UINT32_MAX;
+            }
+            return static_cast<uint32_t>(ceilf(mSteps));
+        }
+
         void step() {
             switch (_state) {
                 case ENVELOPE_STATE::IDLE:
@@ -202,25 +519,24 @@ namespace klangwellen {
                     break;
                 case ENVELOPE_STATE::ATTACK:
                     // increase amp to sustain_level in ATTACK sec
-                    _amplitude += _delta;
-                    if (_amplitude >= 1.0f) {
+                    _amplitude = _amplitude * _coefficient + _delta;
+                    if (_amplitude >= 1.0f - STAGE_TOLERANCE) {
                         _amplitude = 1.0f;
-                        _delta     = compute_delta_fraction(-(1.0f - _sustain), _decay);
-                        setState(ENVELOPE_STATE::DECAY);
+                        enter_decay_state();
                     }
                     break;
                 case ENVELOPE_STATE::DECAY:
                     // decrease amp to sustain_level in DECAY sec
-                    _amplitude += _delta;
-                    if (_amplitude <= _sustain) {
+                    _amplitude = _amplitude * _coefficient + _delta;
+                    if (_amplitude <= _sustain + STAGE_TOLERANCE) {
                         _amplitude = _sustain;
                         setState(ENVELOPE_STATE::SUSTAIN);
                     }
                     break;
                 case ENVELOPE_STATE::RELEASE:
                     // decrease amp to 0.0 in RELEASE sec
-                    _amplitude += _delta;
-                    if (_amplitude <= 0.0f) {
+                    _amplitude = _amplitude * _coefficient + _delta;
+                    if (_amplitude <= STAGE_TOLERANCE) {
                         _amplitude = 0.0f;
                         setState(ENVELOPE_STATE::IDLE);
                     }
@@ -229,14 +545,10 @@ namespace klangwellen {
                     _amplitude += _delta;
                     if (_amplitude <= 0.0f) {
                         _amplitude = 0.0f;
-                        _delta     = compute_delta_fraction(1.0f, _attack);
-                        setState(ENVELOPE_STATE::ATTACK);
+                        enter_attack_state();
                     }
                     break;
             }
         }
     };
-    float ADSR::get_release() const {
-        return _release;
-    }
 } // namespace klangwellen
@@ -0,0 +1,358 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * PROCESSOR INTERFACE
+ *
+ * - [ ] float process()
+ * - [ ] float process(float)
+ * - [ ] void process(AudioSignal&)
+ * - [ ] void process(float*, uint32_t)
+ * - [ ] void process(float*, float*, uint32_t)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "ADSR.h"
+#include "KlangWellen.h"
+
+namespace klangwellen {
+    /**
+     * bank of ADSR envelopes for a fixed number of voices that share the same attack, decay, sustain and release
+     * parameters ( e.g the amplitude envelopes of a polyphonic synthesizer ). the envelopes behave like `ADSR` but the
+     * state of all voices ( amplitude, coefficient, delta and stage ) is stored in arrays. all voices are advanced in
+     * one loop without branches that yields a mask of the voices that completed their stage, stage transitions are
+     * only applied to the masked voices. this allows compilers to advance 4 or 8 voices per SIMD instruction instead
+     * of calling one envelope per voice and sample:
+     * <pre>
+     * <code>
+     *     ADSRBank<16> mEnvelopes(48000);
+     *     float*       mVoiceBuffers[16];
+     *     mEnvelopes.start(3);
+     *     mEnvelopes.process(mVoiceBuffers, 128);
+     * </code>
+     * </pre>
+     */
+    template<uint8_t NUMBER_OF_VOICES>
+    class ADSRBank {
+    public:
+        explicit ADSRBank(const uint32_t sample_rate) : fSampleRate(sample_rate) {
+            update_attack_coefficients();
+            update_decay_coefficients();
+            update_release_coefficients();
+            for (uint8_t v = 0; v < NUMBER_OF_VOICES; v++) {
+                _amplitude[v] = 0.0f;
+                enter_hold(v, STAGE_IDLE);
+            }
+        }
+
+        /**
+         * applies the envelope of each voice to the buffer of the voice. buffers may be nullptr in which case the
+         * envelope of the voice is advanced without output.
+         *
+         * @param signal_buffers one buffer per voice ( i.e `NUMBER_OF_VOICES` buffers )
+         */
+        void process(float** signal_buffers, const uint32_t buffer_length) {
+            float mEnvelope[RENDER_CHUNK_SIZE * NUMBER_OF_VOICES];
+            for (uint32_t i = 0; i < buffer_length; i += RENDER_CHUNK_SIZE) {
+                const uint32_t mLength = std::min(RENDER_CHUNK_SIZE, buffer_length - i);
+                render_chunk(mEnvelope, mLength);
+                for (uint8_t v = 0; v < NUMBER_OF_VOICES; v++) {
+                    if (signal_buffers[v] != nullptr) {
+                        float* mBuffer = signal_buffers[v] + i;
+                        for (uint32_t j = 0; j < mLength; j++) {
+                            mBuffer[j] *= mEnvelope[j * NUMBER_OF_VOICES + v];
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * writes the envelope of each voice into the buffer of the voice instead of applying it to a signal.
+         *
+         * @param envelope_buffers one buffer per voice ( i.e `NUMBER_OF_VOICES` buffers )
+         */
+        void render(float** envelope_buffers, const uint32_t buffer_length) {
+            float mEnvelope[RENDER_CHUNK_SIZE * NUMBER_OF_VOICES];
+            for (uint32_t i = 0; i < buffer_length; i += RENDER_CHUNK_SIZE) {
+                const uint32_t mLength = std::min(RENDER_CHUNK_SIZE, buffer_length - i);
+                render_chunk(mEnvelope, mLength);
+                for (uint8_t v = 0; v < NUMBER_OF_VOICES; v++) {
+                    if (envelope_buffers[v] != nullptr) {
+                        float* mBuffer = envelope_buffers[v] + i;
+                        for (uint32_t j = 0; j < mLength; j++) {
+                            mBuffer[j] = mEnvelope[j * NUMBER_OF_VOICES + v];
+                        }
+                    }
+                }
+            }
+        }
+
+        void start(const uint8_t voice) {
+            if (voice >= NUMBER_OF_VOICES) {
+                return;
+            }
+            _stage[voice]       = STAGE_ATTACK;
+            _coefficient[voice] = _attack_coefficient;
+            _delta[voice]       = _attack_delta;
+            _target[voice]      = 1.0f - STAGE_TOLERANCE;
+            _direction[voice]   = 1.0f;
+            _end[voice]         = 1.0f;
+        }
+
+        void stop(const uint8_t voice) {
+            if (voice >= NUMBER_OF_VOICES || _stage[voice] == STAGE_RELEASE) {
+                return;
+            }
+            _stage[voice] = STAGE_RELEASE;
+            if (_release_curve > 0.0f) {
+                _coefficient[voice] = _release_coefficient;
+                _delta[voice]       = _release_delta;
+            } else {
+                _coefficient[voice] = 1.0f;
+                _delta[voice]       = compute_delta_fraction(-_amplitude[voice], _release);
+            }
+            _target[voice]    = STAGE_TOLERANCE;
+            _direction[voice] = -1.0f;
+            _end[voice]       = 0.0f;
+        }
+
+        /**
+         * @return true if the envelope of the voice has completed its release stage or has not been started
+         */
+        bool is_idle(const uint8_t voice) const {
+            return voice >= NUMBER_OF_VOICES || _stage[voice] == STAGE_IDLE;
+        }
+
+        float get_amplitude(const uint8_t voice) const {
+            return voice < NUMBER_OF_VOICES ? _amplitude[voice] : 0.0f;
+        }
+
+        uint8_t get_number_of_voices() const {
+            return NUMBER_OF_VOICES;
+        }
+
+        float get_attack() const {
+            return _attack;
+        }
+
+        void set_attack(const float attack) {
+            _attack = attack;
+            update_attack_coefficients();
+        }
+
+        void set_adsr(const float attack, const float decay, const float sustain, const float release) {
+            set_attack(attack);
+            set_decay(decay);
+            set_sustain(sustain);
+            set_release(release);
+        }
+
+        float get_decay() const {
+            return _decay;
+        }
+
+        void set_decay(const float decay) {
+            _decay = decay;
+            update_decay_coefficients();
+        }
+
+        float get_sustain() const {
+            return _sustain;
+        }
+
+        void set_sustain(const float sustain) {
+            _sustain = sustain;
+            update_decay_coefficients();
+            update_release_coefficients();
+        }
+
+        float get_release() const {
+            return _release;
+        }
+
+        void set_release(const float release) {
+            _release = release;
+            update_release_coefficients();
+        }
+
+        /**
+         * sets the curvature of attack, decay and release stage ( see `ADSR::set_attack_curve()` ).
+         *
+         * @param curve 0.0 for linear stages ( default ) up to 1.0 for strongly exponential stages
+         */
+        void set_curve(const float curve) {
+            set_attack_curve(curve);
+            set_decay_curve(curve);
+            set_release_curve(curve);
+        }
+
+        void set_attack_curve(const float curve) {
+            _attack_curve = KlangWellen::clamp(curve, 0.0f, 1.0f);
+            update_attack_coefficients();
+        }
+
+        float get_attack_curve() const {
+            return _attack_curve;
+        }
+
+        void set_decay_curve(const float curve) {
+            _decay_curve = KlangWellen::clamp(curve, 0.0f, 1.0f);
+            update_decay_coefficients();
+        }
+
+        float get_decay_curve() const {
+            return _decay_curve;
+        }
+
+        void set_release_curve(const float curve) {
+            _release_curve = KlangWellen::clamp(curve, 0.0f, 1.0f);
+            update_release_coefficients();
+        }
+
+        float get_release_curve() const {
+            return _release_curve;
+        }
+
+    private:
+        static constexpr uint32_t RENDER_CHUNK_SIZE = 16;
+        static constexpr int32_t  STAGE_IDLE        = 0;
+        static constexpr int32_t  STAGE_ATTACK      = 1;
+        static constexpr int32_t  STAGE_DECAY       = 2;
+        static constexpr int32_t  STAGE_SUSTAIN     = 3;
+        static constexpr int32_t  STAGE_RELEASE     = 4;
+        /* same tolerance as `ADSR`, stages end within this distance of their target */
+        static constexpr float    STAGE_TOLERANCE   = 1.0e-5f;
+        /* target of idle and sustain stage, never reached */
+        static constexpr float    HOLD_TARGET       = std::numeric_limits<float>::max();
+
+        const uint32_t fSampleRate;
+        float          _attack              = KlangWellen::DEFAULT_ATTACK;
+        float          _decay               = KlangWellen::DEFAULT_DECAY;
+        float          _sustain             = KlangWellen::DEFAULT_SUSTAIN;
+        float          _release             = KlangWellen::DEFAULT_RELEASE;
+        float          _attack_curve        = 0.0f;
+        float          _decay_curve         = 0.0f;
+        float          _release_curve       = 0.0f;
+        /* coefficients applied when a stage is entered, linear stages use a coefficient of 1 */
+        float          _attack_coefficient  = 1.0f;
+        float          _attack_delta        = 0.0f;
+        float          _decay_coefficient   = 1.0f;
+        float          _decay_delta         = 0.0f;
+        float          _release_coefficient = 1.0f;
+        float          _release_delta       = 0.0f;
+
+        /*
+         * per voice state. amplitude is advanced as `amplitude * coefficient + delta`, a stage ends once
+         * `( amplitude - target ) * direction` is not negative and the amplitude is then set to `end`.
+         */
+        float   _amplitude[NUMBER_OF_VOICES];
+        float   _coefficient[NUMBER_OF_VOICES];
+        float   _delta[NUMBER_OF_VOICES];
+        float   _target[NUMBER_OF_VOICES];
+        float   _direction[NUMBER_OF_VOICES];
+        float   _end[NUMBER_OF_VOICES];
+        int32_t _stage[NUMBER_OF_VOICES];
+        int32_t _reached[NUMBER_OF_VOICES];
+
+        /* envelopes are rendered sample by sample into rows of `NUMBER_OF_VOICES` amplitudes */
+        void render_chunk(float* envelope, const uint32_t length) {
+            for (uint32_t j = 0; j < length; j++) {
+                step(envelope + j * NUMBER_OF_VOICES);
+            }
+        }
+
+        /*
+         * advances all voices in a loop without branches and marks the voices that reached the end of their stage. stage
+         * transitions are rare and applied afterwards to the marked voices only.
+         */
+        void step(float* amplitudes) {
+            int32_t mTransitions = 0;
+            for (uint8_t v = 0; v < NUMBER_OF_VOICES; v++) {
+                const float   mAmplitude = _amplitude[v] * _coefficient[v] + _delta[v];
+                const float   mEnd       = _end[v];
+                const int32_t mReached   = (mAmplitude - _target[v]) * _direction[v] >= 0.0f;
+                _amplitude[v]            = mReached ? mEnd : mAmplitude;
+                amplitudes[v]            = _amplitude[v];
+                _reached[v]              = mReached;
+                mTransitions |= mReached;
+            }
+            if (mTransitions) {
+                for (uint8_t v = 0; v < NUMBER_OF_VOICES; v++) {
+                    if (_reached[v]) {
+                        if (_stage[v] == STAGE_ATTACK) {
+                            enter_decay(v);
+                        } else if (_stage[v] == STAGE_DECAY) {
+                            enter_hold(v, STAGE_SUSTAIN);
+                        } else {
+                            enter_hold(v, STAGE_IDLE);
+                        }
+                    }
+                }
+            }
+        }
+
+        void enter_decay(const uint8_t voice) {
+            _stage[voice]       = STAGE_DECAY;
+            _coefficient[voice] = _decay_coefficient;
+            _delta[voice]       = _decay_delta;
+            _target[voice]      = _sustain + STAGE_TOLERANCE;
+            _direction[voice]   = -1.0f;
+            _end[voice]         = _sustain;
+        }
+
+        /* idle and sustain stage hold the current amplitude */
+        void enter_hold(const uint8_t voice, const int32_t stage) {
+            _stage[voice]       = stage;
+            _coefficient[voice] = 1.0f;
+            _delta[voice]       = 0.0f;
+            _target[voice]      = HOLD_TARGET;
+            _direction[voice]   = 1.0f;
+            _end[voice]         = _amplitude[voice];
+        }
+
+        void update_attack_coefficients() {
+            ADSR::compute_curve_coefficients(0.0f, 1.0f, _attack, _attack_curve, fSampleRate, _attack_coefficient, _attack_delta);
+            if (_attack_curve <= 0.0f) {
+                _attack_delta = compute_delta_fraction(1.0f, _attack);
+            }
+        }
+
+        void update_decay_coefficients() {
+            ADSR::compute_curve_coefficients(1.0f, _sustain, _decay, _decay_curve, fSampleRate, _decay_coefficient, _decay_delta);
+            if (_decay_curve <= 0.0f) {
+                _decay_delta = compute_delta_fraction(-(1.0f - _sustain), _decay);
+            }
+        }
+
+        void update_release_coefficients() {
+            ADSR::compute_curve_coefficients(_sustain, 0.0f, _release, _release_curve, fSampleRate, _release_coefficient, _release_delta);
+        }
+
+        float compute_delta_fraction(const float delta, const float duration) const {
+            return duration > 0 ? (delta / static_cast<float>(fSampleRate)) / duration : delta;
+        }
+    };
+} // namespace klangwellen
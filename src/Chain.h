@@ -0,0 +1,150 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * PROCESSOR INTERFACE
+ *
+ * - [x] float process()
+ * - [x] float process(float)
+ * - [ ] void process(AudioSignal&)
+ * - [x] void process(float*, uint32_t)
+ * - [ ] void process(float*, float*, uint32_t)
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace klangwellen {
+    /**
+     * chains processors at compile time without virtual methods. the chain holds references to the processors and
+     * passes the signal from one processor to the next:
+     * <pre>
+     * <code>
+     *     Chain mChain(mWavetable, mADSR, mFilter, mReverb);
+     *     mChain.process(mBuffer, 128);        // one loop with all processors fused per sample
+     *     mChain.process_blocks(mBuffer, 128); // each processor processes the whole block in turn
+     * </code>
+     * </pre>
+     * each processor is called with `float process(float)` if available. processors that only generate a signal ( i.e
+     * `float process()` like `Wavetable` ) overwrite the signal and are usually placed at the head of the chain.
+     *
+     * `process(float*, uint32_t)` fuses the per-sample `process` methods of all processors into a single loop, which
+     * keeps the signal in registers and lets the compiler inline the whole chain. `process_blocks(float*, uint32_t)`
+     * instead calls the block `process` method of each processor ( if available ), which is faster for processors with
+     * an optimized block implementation ( e.g `ADSR` ). chains can be nested:
+     * <pre>
+     * <code>
+     *     Chain mInner(mADSR, mFilter);
+     *     Chain mOuter(mWavetable, mInner);
+     *     Chain<decltype(mInner)> mWrapped(mInner); // a single chain argument needs explicit template arguments
+     * </code>
+     * </pre>
+     * note, that `Chain mOuter(mInner)` with a single chain argument deduces the copy constructor ( i.e `mOuter` is a
+     * copy of `mInner` ) instead of nesting `mInner`.
+     */
+    template<typename... PROCESSORS>
+    class Chain {
+    public:
+        static_assert(sizeof...(PROCESSORS) > 0, "chain must contain at least one processor");
+
+        explicit Chain(PROCESSORS&... processors) : _processors(processors...) {}
+
+        /**
+         * @return processor at position INDEX of the chain
+         */
+        template<size_t INDEX>
+        auto& get() {
+            return std::get<INDEX>(_processors);
+        }
+
+        static constexpr size_t size() {
+            return sizeof...(PROCESSORS);
+        }
+
+        float process() {
+            return process(0.0f);
+        }
+
+        float process(float signal) {
+            return process_sample(signal, std::index_sequence_for<PROCESSORS...>{});
+        }
+
+        void process(float* signal_buffer, const uint32_t length) {
+            for (uint32_t i = 0; i < length; i++) {
+                signal_buffer[i] = process(signal_buffer[i]);
+            }
+        }
+
+        void process_blocks(float* signal_buffer, const uint32_t length) {
+            process_block(signal_buffer, length, std::index_sequence_for<PROCESSORS...>{});
+        }
+
+    private:
+        std::tuple<PROCESSORS&...> _processors;
+
+        template<typename T, typename = void>
+        struct has_process_sample : std::false_type {};
+
+        template<typename T>
+        struct has_process_sample<T, std::void_t<decltype(std::declval<T&>().process(0.0f))>> : std::true_type {};
+
+        template<typename T, typename = void>
+        struct has_process_block : std::false_type {};
+
+        template<typename T>
+        struct has_process_block<T, std::void_t<decltype(std::declval<T&>().process(std::declval<float*>(), uint32_t{}))>> : std::true_type {};
+
+        template<typename PROCESSOR>
+        static float process_sample(PROCESSOR& processor, const float signal) {
+            if constexpr (has_process_sample<PROCESSOR>::value) {
+                return processor.process(signal);
+            } else {
+                return processor.process();
+            }
+        }
+
+        template<typename PROCESSOR>
+        static void process_block(PROCESSOR& processor, float* signal_buffer, const uint32_t length) {
+            if constexpr (has_process_block<PROCESSOR>::value) {
+                processor.process(signal_buffer, length);
+            } else {
+                for (uint32_t i = 0; i < length; i++) {
+                    signal_buffer[i] = process_sample(processor, signal_buffer[i]);
+                }
+            }
+        }
+
+        template<size_t... INDICES>
+        float process_sample(float signal, std::index_sequence<INDICES...>) {
+            ((signal = process_sample(std::get<INDICES>(_processors), signal)), ...);
+            return signal;
+        }
+
+        template<size_t... INDICES>
+        void process_block(float* signal_buffer, const uint32_t length, std::index_sequence<INDICES...>) {
+            (process_block(std::get<INDICES>(_processors), signal_buffer, length), ...);
+        }
+    };
+} // namespace klangwellen
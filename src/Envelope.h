@@ -62,11 +62,24 @@
  * <li>interpolate from <code>0.0</code> to <code>1.0</code> in <code>2.0</code> seconds
  * <li>envelope is done
  * </ul>
+ * <p>
+ * stages are stored in a table of fixed capacity ( see `KLANGWELLEN_ENVELOPE_MAX_STAGES` ) and compiled into a
+ * per-sample increment and a number of samples when they are added or when the time scale changes. adding stages and
+ * changing the time scale never allocates memory.
  */
 
 #pragma once
 
-#include <vector>
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "ScheduledEvent.h"
+
+#ifndef KLANGWELLEN_ENVELOPE_MAX_STAGES
+#define KLANGWELLEN_ENVELOPE_MAX_STAGES 16
+#endif
 
 namespace klangwellen {
     class Envelope {
@@ -87,6 +100,8 @@ namespace klangwellen {
          *
          */
     public:
+        static constexpr uint8_t MAX_STAGES = KLANGWELLEN_ENVELOPE_MAX_STAGES;
+
         class Stage {
         public:
             /**
@@ -124,33 +139,84 @@ namespace klangwellen {
          */
         float process() {
             if (!_envelope_done) {
-                const int mNumberOfStages = _envelope_stages.size();
-                if (_envelope_stage < mNumberOfStages) {
-                    _value += _time_scale * _delta;
-                    _stage_duration += _time_scale * 1.0f / _sample_rate;
-                    if (_stage_duration > _envelope_stages[_envelope_stage].duration) {
-                        const float mRemainder = _stage_duration - _envelope_stages[_envelope_stage].duration;
-                        finished_stage(_envelope_stage);
-                        _envelope_stage++;
-                        if (_envelope_stage < mNumberOfStages - 1) {
-                            prepareNextStage(_envelope_stage, mRemainder);
-                        } else {
-                            stop();
-                            finished_envelope();
-                        }
+                _stage_position++;
+                if (_stage_position >= _stage_samples[_envelope_stage]) {
+                    finished_stage(_envelope_stage);
+                    _envelope_stage++;
+                    if (_envelope_stage < _number_of_stages - 1) {
+                        prepareNextStage(_envelope_stage);
+                    } else {
+                        _value = _envelope_stages[_number_of_stages - 1].value;
+                        stop();
+                        finished_envelope();
                     }
+                } else {
+                    _value = value_at(_stage_position);
                 }
             }
             return _value;
         }
 
+        /**
+         * writes the envelope into a buffer. the block is split into segments at stage boundaries, the samples of a
+         * segment are computed from the start value and the increment of the stage.
+         */
         void process(float*         signal_buffer,
                      const uint32_t length) {
-            for (uint32_t i = 0; i < length; i++) {
-                signal_buffer[i] = process();
+            uint32_t mOffset = 0;
+            while (mOffset < length) {
+                if (_envelope_done) {
+                    std::fill_n(signal_buffer + mOffset, length - mOffset, _value);
+                    return;
+                }
+                /* fill up to the sample before the stage boundary, the boundary itself is handled by `process()` */
+                const uint32_t mSamples = _stage_samples[_envelope_stage];
+                const uint32_t mSegment = _stage_position + 1 >= mSamples ? 0 : std::min(mSamples - _stage_position - 1, length - mOffset);
+                if (mSegment > 0) {
+                    const float    mStart     = _envelope_stages[_envelope_stage].value;
+                    const float    mIncrement = _stage_increments[_envelope_stage];
+                    const uint32_t mPosition  = _stage_position;
+                    float*         mBuffer    = signal_buffer + mOffset;
+                    for (uint32_t i = 0; i < mSegment; i++) {
+                        mBuffer[i] = mStart + mIncrement * static_cast<float>(mPosition + i + 1);
+                    }
+                    _stage_position += mSegment;
+                    _value = value_at(_stage_position);
+                    mOffset += mSegment;
+                }
+                if (mOffset < length) {
+                    signal_buffer[mOffset] = process();
+                    mOffset++;
+                }
             }
         }
 
+        /**
+         * writes the envelope into a buffer and starts or stops it sample-accurately at the offsets of the scheduled
+         * events ( `KlangWellen::EVENT_NOTE_ON` starts, `KlangWellen::EVENT_NOTE_OFF` stops the envelope ).
+         *
+         * @param events           events sorted by offset
+         * @param number_of_events number of events
+         * @return number of applied events ( see `process_scheduled_events()` )
+         */
+        uint32_t process(float*                signal_buffer,
+                         const uint32_t        length,
+                         const ScheduledEvent* events,
+                         const uint32_t        number_of_events) {
+            return process_scheduled_events(
+                length, events, number_of_events,
+                [&](const uint32_t offset, const uint32_t segment_length) {
+                    process(signal_buffer + offset, segment_length);
+                },
+                [&](const ScheduledEvent& event) {
+                    if (event.type == KlangWellen::EVENT_NOTE_ON) {
+                        start();
+                    } else if (event.type == KlangWellen::EVENT_NOTE_OFF) {
+                        stop();
+                    }
+                });
+        }
+
         /**
          * clears all current stages from the envelope and creates a ramp from start to end value in specified duration.
          *
@@ -159,62 +225,104 @@ namespace klangwellen {
          * @param pDuration   duration of ramp
          */
         void ramp(const float pStartValue, const float pEndValue, const float pDuration) {
-            _envelope_stages.clear();
+            clear_stages();
             add_stage(pStartValue, pDuration);
             add_stage(pEndValue);
         }
 
         /**
          * clears all current stages from envelope and creates a ramp from the current value to specified value in specified
-         * duration. note, that the envelope might need to be restarted with `start()`.
+         * duration. note, that the envelope needs to be restarted with `start()`.
          *
          * @param pValue    end value of ramp
          * @param pDuration duration of ramp
          */
         void ramp_to(const float pValue, const float pDuration) {
-            _envelope_stages.clear();
-            add_stage(_value, pDuration);
+            const float mValue = _value;
+            clear_stages();
+            add_stage(mValue, pDuration);
             add_stage(pValue);
         }
 
         /**
-         * @return list of all stages
+         * @return list of all stages ( see `get_number_of_stages()` )
          */
-        std::vector<Stage>& stages() {
+        const Stage* stages() const {
             return _envelope_stages;
         }
 
+        uint8_t get_number_of_stages() const {
+            return _number_of_stages;
+        }
+
         /**
          * @param pValue    value of stage
          * @param pDuration duration of stage
+         * @return false if the maximum number of stages is reached
          */
-        void add_stage(const float pValue, const float pDuration) {
-            _envelope_stages.push_back(Stage(pValue, pDuration));
+        bool add_stage(const float pValue, const float pDuration) {
+            if (_number_of_stages >= MAX_STAGES) {
+                return false;
+            }
+            _envelope_stages[_number_of_stages] = Stage(pValue, pDuration);
+            _number_of_stages++;
+            /* the increment of a stage depends on the value of the following stage */
+            if (_number_of_stages > 1) {
+                compile_stage(_number_of_stages - 2);
+            }
+            compile_stage(_number_of_stages - 1);
+            clamp_stage_position();
+            return true;
         }
 
         /**
          * @param pValue value of stage
+         * @return false if the maximum number of stages is reached
          */
-        void add_stage(const float pValue) {
-            _envelope_stages.push_back(Stage(pValue, 0.0f));
+        bool add_stage(const float pValue) {
+            return add_stage(pValue, 0.0f);
         }
 
         /**
+         * changes value and duration of an existing stage. if the running stage is shortened below its current position
+         * the envelope continues with the next stage.
          *
+         * @return false if the stage does not exist
+         */
+        bool set_stage(const uint8_t pStage, const float pValue, const float pDuration) {
+            if (pStage >= _number_of_stages) {
+                return false;
+            }
+            _envelope_stages[pStage] = Stage(pValue, pDuration);
+            if (pStage > 0) {
+                compile_stage(pStage - 1);
+            }
+            compile_stage(pStage);
+            clamp_stage_position();
+            return true;
+        }
+
+        /**
+         * clears all stages and stops the envelope.
          */
         void clear_stages() {
-            _envelope_stages.clear();
+            _number_of_stages = 0;
+            stop();
         }
 
         /**
          *
          */
         void start() {
-            _envelope_done = false;
-            if (!_envelope_stages.empty()) {
-                prepareNextStage(0, 0.0f);
+            if (_number_of_stages < 2) {
+                if (_number_of_stages == 1) {
+                    _value = _envelope_stages[0].value;
+                }
+                stop();
+                return;
             }
-            _stage_duration = 0.0f;
+            _envelope_done = false;
+            prepareNextStage(0);
         }
 
         /**
@@ -232,10 +340,22 @@ namespace klangwellen {
         }
 
         /**
+         * sets the time scale. the increments of all stages are recomputed, the position of a running stage is scaled
+         * accordingly.
+         *
          * @param pTimeScale time scale in seconds
          */
         void set_time_scale(const float pTimeScale) {
-            _time_scale = pTimeScale;
+            const uint32_t mSamples = _stage_samples[_envelope_stage];
+            _time_scale             = pTimeScale;
+            for (uint8_t i = 0; i < _number_of_stages; i++) {
+                compile_stage(i);
+            }
+            if (!_envelope_done) {
+                const float mPosition = static_cast<float>(_stage_position) / static_cast<float>(mSamples);
+                _stage_position       = static_cast<uint32_t>(mPosition * static_cast<float>(_stage_samples[_envelope_stage]));
+                clamp_stage_position();
+            }
         }
 
         /**
@@ -246,22 +366,52 @@ namespace klangwellen {
         }
 
         /**
-         * @param pValue set current value
+         * @param pValue set current value. note, that a running envelope replaces the value with the next step.
          */
         void set_current_value(const float pValue) {
             _value = pValue;
         }
 
     private:
-        const float        _sample_rate;
-        std::vector<Stage> _envelope_stages;
-        float              _delta          = 0.0f;
-        int                _envelope_stage = 0;
-        bool               _envelope_done  = true;
-        bool               _loop           = false;
-        float              _stage_duration = 0.0f;
-        float              _time_scale     = 1.0f;
-        float              _value          = 0.0f;
+        const float _sample_rate;
+        Stage       _envelope_stages[MAX_STAGES];
+        /* compiled stages, value of stage `i` after `n` samples is `value + n * increment` */
+        float       _stage_increments[MAX_STAGES] = {};
+        uint32_t    _stage_samples[MAX_STAGES]    = {};
+        uint8_t     _number_of_stages             = 0;
+        uint8_t     _envelope_stage               = 0;
+        uint32_t    _stage_position               = 0;
+        bool        _envelope_done                = true;
+        bool        _loop                         = false;
+        float       _time_scale                   = 1.0f;
+        float       _value                        = 0.0f;
+
+        float value_at(const uint32_t position) const {
+            return _envelope_stages[_envelope_stage].value + _stage_increments[_envelope_stage] * static_cast<float>(position);
+        }
+
+        /* computes increment per sample and duration in samples of a stage, the duration of the last stage is ignored */
+        void compile_stage(const uint8_t stage) {
+            if (stage + 1 >= _number_of_stages || _time_scale <= 0.0f) {
+                _stage_increments[stage] = 0.0f;
+                _stage_samples[stage]    = UINT32_MAX;
+                return;
+            }
+            const float mDelta       = _envelope_stages[stage + 1].value - _envelope_stages[stage].value;
+            const float mDuration    = std::max(_envelope_stages[stage].duration, 0.0f);
+            const float mSamples     = mDuration * _sample_rate / _time_scale;
+            _stage_increments[stage] = _time_scale * compute_delta_fraction(mDelta, mDuration);
+            /* a stage lasts at least one sample, the guard keeps durations like 0.1f from rounding up a sample */
+            _stage_samples[stage]    = mSamples < 4.0e9f ? std::max(static_cast<uint32_t>(ceilf(mSamples - 1.0e-3f)), 1u) : UINT32_MAX;
+        }
+
+        /* keeps the position of the running stage inside the stage after its duration changed, the stage ends with the
+         * next step */
+        void clamp_stage_position() {
+            if (!_envelope_done && _stage_position >= _stage_samples[_envelope_stage]) {
+                _stage_position = _stage_samples[_envelope_stage] - 1;
+            }
+        }
 
         float compute_delta_fraction(const float pDelta, const float pDuration) const {
             return pDuration > 0 ? (pDelta / _sample_rate) / pDuration : pDelta;
@@ -278,21 +428,10 @@ namespace klangwellen {
             // TODO implement stage finished callback
         }
 
-        void prepareNextStage(const int stage, const float fraction) {
+        void prepareNextStage(const uint8_t stage) {
             _envelope_stage = stage;
-            _stage_duration = 0.0f;
-            // @TODO maybe keep fractional part.
-            (void) fraction;
-            // @TODO but take care to also factor in the fraction when computing the delta in `setDelta`
-            _value = _envelope_stages[_envelope_stage].value;
-            if (_envelope_stages.size() > 1) {
-                setDelta(_envelope_stage);
-            }
-        }
-
-        void setDelta(const int pEnvStage) {
-            const float mDeltaTMP = _envelope_stages[pEnvStage + 1].value - _envelope_stages[pEnvStage].value;
-            _delta                = compute_delta_fraction(mDeltaTMP, _envelope_stages[_envelope_stage].duration);
+            _stage_position = 0;
+            _value          = _envelope_stages[_envelope_stage].value;
         }
     };
 } // namespace klangwellen
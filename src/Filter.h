@@ -46,6 +46,17 @@ namespace klangwellen {
         static constexpr uint8_t HSH              = 6; /* High shelf filter */
         static constexpr uint8_t NUM_FILTER_TYPES = 7;
 
+        /**
+         * normalized biquad coefficients as computed by `compute_coefficients()`
+         */
+        struct Coefficients {
+            float a0 = 0.0f;
+            float a1 = 0.0f;
+            float a2 = 0.0f;
+            float a3 = 0.0f;
+            float a4 = 0.0f;
+        };
+
         explicit Filter(const float sample_rate, const bool use_fast_math = true) : _sample_rate(sample_rate), __USE_FAST_TRIG(use_fast_math) {
             set(LPF, 0.0, 1000, 2);
         }
@@ -91,6 +102,24 @@ namespace klangwellen {
                  const float   dbGain, /* gain of filter */
                  const float   center_frequency,
                  const float   bandwidth /* bandwidth in octaves */) {
+            Coefficients mCoefficients;
+            if (compute_coefficients(type, dbGain, center_frequency, bandwidth, mCoefficients)) {
+                set_coefficients(mCoefficients);
+            }
+        }
+
+        /**
+         * computes the coefficients for a filter configuration without changing the filter. this may run on a different
+         * thread than `process()`, the coefficients can then be applied with `set_coefficients()` ( e.g via a
+         * `ParameterQueue` ).
+         *
+         * @return false if the filter type is unknown
+         */
+        bool compute_coefficients(const uint8_t type,
+                                  const float   dbGain, /* gain of filter */
+                                  const float   center_frequency,
+                                  const float   bandwidth, /* bandwidth in octaves */
+                                  Coefficients& coefficients) const {
             float a0, a1, a2, b0, b1, b2;
 
             const float A     = KlangWellen::pow(10, dbGain / 40.0f);
@@ -169,15 +198,24 @@ namespace klangwellen {
                     a2 = (A + 1) - (A - 1) * cs - beta * sn;
                     break;
                 default:
-                    return;
+                    return false;
             }
 
             /* precompute the coefficients. */
-            biquad_a0 = b0 / a0;
-            biquad_a1 = b1 / a0;
-            biquad_a2 = b2 / a0;
-            biquad_a3 = a1 / a0;
-            biquad_a4 = a2 / a0;
+            coefficients.a0 = b0 / a0;
+            coefficients.a1 = b1 / a0;
+            coefficients.a2 = b2 / a0;
+            coefficients.a3 = a1 / a0;
+            coefficients.a4 = a2 / a0;
+            return true;
+        }
+
+        void set_coefficients(const Coefficients& coefficients) {
+            biquad_a0 = coefficients.a0;
+            biquad_a1 = coefficients.a1;
+            biquad_a2 = coefficients.a2;
+            biquad_a3 = coefficients.a3;
+            biquad_a4 = coefficients.a4;
         }
 
         void reset() {
@@ -188,8 +226,8 @@ namespace klangwellen {
     private:
         static constexpr float FILTER_LN2 = 0.69314718055994530942;
         static constexpr float FILTER_PI  = 3.14159265358979323846;
-        float                  biquad_a0, biquad_a1, biquad_a2, biquad_a3, biquad_a4 = 0;
-        float                  biquad_x1, biquad_x2, biquad_y1, biquad_y2 = 0;
+        float                  biquad_a0 = 0, biquad_a1 = 0, biquad_a2 = 0, biquad_a3 = 0, biquad_a4 = 0;
+        float                  biquad_x1 = 0, biquad_x2 = 0, biquad_y1 = 0, biquad_y2 = 0;
         const float            _sample_rate;
         const bool             __USE_FAST_TRIG;
     };
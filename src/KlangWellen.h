@@ -36,6 +36,15 @@ static constexpr float KW_HALF_PI = M_PI / 2;
 #define KLANGWELLEN_WAVETABLE_INTERPOLATE_SAMPLES 1
 #endif
 
+/* bare metal targets ( e.g Klangstrom on arm-none-eabi ) run single-threaded and may not support thread local storage */
+#ifndef KLANGWELLEN_THREAD_LOCAL
+#if defined(KLANGSTROM) || defined(ARDUINO) || (defined(__arm__) && !defined(__linux__) && !defined(__APPLE__) && !defined(_WIN32))
+#define KLANGWELLEN_THREAD_LOCAL
+#else
+#define KLANGWELLEN_THREAD_LOCAL thread_local
+#endif
+#endif
+
 namespace klangwellen {
     class KlangWellen {
     public:
@@ -86,6 +95,8 @@ namespace klangwellen {
         static constexpr uint8_t NOISE_GAUSSIAN_WHITE_FAST             = 3;
         static constexpr uint8_t NOISE_GAUSSIAN_WHITE                  = 4;
         static constexpr uint8_t NOISE_SIMPLEX                         = 5;
+        static constexpr uint8_t NOISE_BROWN                           = 6;
+        static constexpr uint8_t NOISE_GREY                            = 7;
         static constexpr float   NOTE_WHOLE                            = 0.25f;
         static constexpr float   NOTE_HALF                             = 0.5f;
         static constexpr uint8_t NOTE_QUARTER                          = 1;
@@ -124,6 +135,8 @@ namespace klangwellen {
         static constexpr uint8_t STEREO                                = 2;
         static constexpr uint8_t VERSION_MAJOR                         = 0;
         static constexpr uint8_t VERSION_MINOR                         = 8;
+        static constexpr uint8_t VOICE_STEALING_OLDEST                 = 0;
+        static constexpr uint8_t VOICE_STEALING_QUIETEST               = 1;
         static constexpr uint8_t WAVEFORM_SINE                         = 0;
         static constexpr uint8_t WAVEFORM_TRIANGLE                     = 1;
         static constexpr uint8_t WAVEFORM_SAWTOOTH                     = 2;
@@ -146,6 +159,17 @@ namespace klangwellen {
             return 20.0f * log10(volume);
         }
 
+        /**
+         * @return true if the host stores multibyte values in little endian byte order
+         */
+        static bool is_host_little_endian() {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            return false;
+#else
+            return true;
+#endif
+        }
+
         static constexpr float   MIDI_NOTE_CONVERSION_BASE_FREQUENCY = 440.0;
         static constexpr uint8_t NOTE_OFFSET                         = 69;
 
@@ -208,7 +232,7 @@ namespace klangwellen {
         // static uint32_t x32Seed;
         // static uint32_t xorshift32();
         // static float    random();
-        inline static uint32_t x32Seed = 23;
+        inline static KLANGWELLEN_THREAD_LOCAL uint32_t x32Seed = 23;
 
         static uint32_t millis_to_samples(const float pMillis, const float pSampleRate) {
             return static_cast<uint32_t>(pMillis / 1000.0f * pSampleRate);
@@ -39,58 +39,179 @@
 #include <random>
 
 #include "KlangWellen.h"
+#include "Random.h"
 
 namespace klangwellen {
     /**
-    * supplies a collection of noise generators: white, gaussian, pink and simplex/perlin noise.
+    * supplies a collection of noise generators: white, gaussian, pink, brown, grey and simplex/perlin noise.
     */
 
     class WhiteNoise {
     public:
         float process() {
-            return 2.0f * static_cast<float>(rand()) / static_cast<float>(RAND_MAX) - 1.0;
+            return fRandom.next_signed();
         }
-    };
 
-    class WhiteNoiseFast {
-    public:
-        float process() {
-            return KlangWellen::random() * 2.0 - 1.0;
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            fRandom.process(signal_buffer, buffer_length);
         }
+
+        void set_seed(const uint32_t seed) {
+            fRandom.set_seed(seed);
+        }
+
+    private:
+        Random fRandom;
     };
 
+    /**
+     * kept for compatibility, since `WhiteNoise` uses the same fast per-instance generator.
+     */
+    class WhiteNoiseFast : public WhiteNoise {};
+
+    /**
+     * pink noise ( -3dB per octave ) generated with the Voss-McCartney algorithm. the output is the sum of
+     * `PINK_NOISE_NUM_ROWS` white noise values where row `n` is updated every 2^n samples, plus one white noise value
+     * per sample. only one row changes per sample which makes the generator cheap and independent of the sample rate.
+     */
     class PinkNoise {
     public:
         PinkNoise() {
-            srand(time(nullptr)); // initialize random generator
             clear();
         }
 
         void clear() {
-            for (size_t i = 0; i < PINK_NOISE_NUM_STAGES; i++)
-                state[i] = 0.0;
+            for (uint8_t i = 0; i < PINK_NOISE_NUM_ROWS; i++) {
+                fRows[i] = 0.0f;
+            }
+            fRunningSum = 0.0f;
+            fCounter    = 0;
+        }
+
+        float process() {
+            update_row();
+            return (fRunningSum + fRandom.next_signed()) * SCALE;
+        }
+
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            fRandom.process(signal_buffer, buffer_length);
+            for (uint32_t i = 0; i < buffer_length; i++) {
+                update_row();
+                signal_buffer[i] = (fRunningSum + signal_buffer[i]) * SCALE;
+            }
+        }
+
+        void set_seed(const uint32_t seed) {
+            fRandom.set_seed(seed);
+        }
+
+    private:
+        static constexpr uint8_t  PINK_NOISE_NUM_ROWS = 16;
+        static constexpr uint32_t COUNTER_MASK        = (1 << PINK_NOISE_NUM_ROWS) - 1;
+        static constexpr float    SCALE               = 1.0f / (PINK_NOISE_NUM_ROWS + 1);
+        float                     fRows[PINK_NOISE_NUM_ROWS];
+        float                     fRunningSum;
+        uint32_t                  fCounter;
+        Random                    fRandom;
+
+        /* the row to update is the number of trailing zeros of the counter */
+        void update_row() {
+            fCounter = (fCounter + 1) & COUNTER_MASK;
+            if (fCounter == 0) {
+                return;
+            }
+            uint32_t mCounter = fCounter;
+            uint8_t  mRow     = 0;
+            while ((mCounter & 1) == 0) {
+                mCounter >>= 1;
+                mRow++;
+            }
+            const float mValue = fRandom.next_signed();
+            fRunningSum += mValue - fRows[mRow];
+            fRows[mRow] = mValue;
+        }
+    };
+
+    /**
+     * brown noise ( -6dB per octave ) generated by integrating white noise. a slight leak keeps the signal from
+     * drifting, the output is clamped to -1.0 ... 1.0.
+     */
+    class BrownNoise {
+    public:
+        void clear() {
+            fState = 0.0f;
         }
 
         float process() {
-            static constexpr float RMI2   = 2.0 / static_cast<float>(RAND_MAX); // + 1.0; // change for range [0,1)
-            static constexpr float offset = A[0] + A[1] + A[2];
+            return integrate(fRandom.next_signed());
+        }
+
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            fRandom.process(signal_buffer, buffer_length);
+            for (uint32_t i = 0; i < buffer_length; i++) {
+                signal_buffer[i] = integrate(signal_buffer[i]);
+            }
+        }
 
-            // unrolled loop
-            float temp = static_cast<float>(rand());
-            state[0]   = P[0] * (state[0] - temp) + temp;
-            temp       = static_cast<float>(rand());
-            state[1]   = P[1] * (state[1] - temp) + temp;
-            temp       = static_cast<float>(rand());
-            state[2]   = P[2] * (state[2] - temp) + temp;
-            return ((A[0] * state[0] + A[1] * state[1] + A[2] * state[2]) * RMI2 - offset) * fScale;
+        void set_seed(const uint32_t seed) {
+            fRandom.set_seed(seed);
         }
 
     private:
-        static constexpr uint8_t PINK_NOISE_NUM_STAGES    = 3;
-        static constexpr float   A[PINK_NOISE_NUM_STAGES] = {0.02109238, 0.07113478, 0.68873558};
-        static constexpr float   P[PINK_NOISE_NUM_STAGES] = {0.3190, 0.7756, 0.9613};
-        float                    state[PINK_NOISE_NUM_STAGES];
-        float                    fScale = 7.0f;
+        static constexpr float LEAK   = 0.998f;
+        static constexpr float GAIN   = 0.04f;
+        static constexpr float SCALE  = 1.0f;
+        float                  fState = 0.0f;
+        Random                 fRandom;
+
+        float integrate(const float white) {
+            fState = fState * LEAK + white * GAIN;
+            return KlangWellen::clamp(fState * SCALE, -1.0f, 1.0f);
+        }
+    };
+
+    /**
+     * grey noise approximates white noise that is perceived equally loud at all frequencies. the inverted equal
+     * loudness curve is approximated by mixing brown noise ( rising towards low frequencies ) and violet noise (
+     * rising towards high frequencies ), the mix has its minimum at approx 3.5kHz at a sample rate of 48kHz.
+     */
+    class GreyNoise {
+    public:
+        void clear() {
+            fBrown = 0.0f;
+            fWhite = 0.0f;
+        }
+
+        float process() {
+            return mix(fRandom.next_signed());
+        }
+
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            fRandom.process(signal_buffer, buffer_length);
+            for (uint32_t i = 0; i < buffer_length; i++) {
+                signal_buffer[i] = mix(signal_buffer[i]);
+            }
+        }
+
+        void set_seed(const uint32_t seed) {
+            fRandom.set_seed(seed);
+        }
+
+    private:
+        static constexpr float LEAK        = 0.998f;
+        static constexpr float BROWN_GAIN  = 0.05f;
+        static constexpr float VIOLET_GAIN = 0.245f;
+        static constexpr float SCALE       = 0.8f;
+        float                  fBrown      = 0.0f;
+        float                  fWhite      = 0.0f;
+        Random                 fRandom;
+
+        float mix(const float white) {
+            fBrown              = fBrown * LEAK + white * BROWN_GAIN;
+            const float mViolet = (white - fWhite) * VIOLET_GAIN;
+            fWhite              = white;
+            return KlangWellen::clamp((fBrown + mViolet) * SCALE, -1.0f, 1.0f);
+        }
     };
 
     class SimplexNoise {
@@ -129,6 +250,84 @@ namespace klangwellen {
             return get(0, x, 0, 0);
         }
 
+        /**
+         * evaluates 1D simplex noise. much cheaper than a 1D slice of the 3D noise ( i.e `get(x)` ), which makes it the
+         * preferred choice for LFOs and other control signals.
+         *
+         * @param offset selects one of 256 independent noise patterns
+         * @return noise value between -1.0 ... 1.0
+         */
+        float get_1d(const unsigned char offset, const float x) const {
+            const int   i  = FastFloor(x);
+            const float x0 = x - i;
+            const float x1 = x0 - 1;
+
+            float t0 = 1 - x0 * x0;
+            t0 *= t0;
+            const float n0 = t0 * t0 * GradCoord1D(offset, i, x0);
+
+            float t1 = 1 - x1 * x1;
+            t1 *= t1;
+            const float n1 = t1 * t1 * GradCoord1D(offset, i + 1, x1);
+
+            return 0.395f * (n0 + n1);
+        }
+
+        /**
+         * evaluates 2D simplex noise.
+         *
+         * @param offset selects one of 256 independent noise patterns
+         * @return noise value between -1.0 ... 1.0
+         */
+        float get_2d(const unsigned char offset, const float x, const float y) const {
+            float     t = (x + y) * F2;
+            const int i = FastFloor(x + t);
+            const int j = FastFloor(y + t);
+
+            t              = (i + j) * G2;
+            const float x0 = x - (i - t);
+            const float y0 = y - (j - t);
+
+            int i1, j1;
+            if (x0 > y0) {
+                i1 = 1;
+                j1 = 0;
+            } else {
+                i1 = 0;
+                j1 = 1;
+            }
+
+            const float x1 = x0 - i1 + G2;
+            const float y1 = y0 - j1 + G2;
+            const float x2 = x0 - 1 + 2 * G2;
+            const float y2 = y0 - 1 + 2 * G2;
+
+            float n0, n1, n2;
+
+            t = static_cast<float>(0.5) - x0 * x0 - y0 * y0;
+            if (t < 0) n0 = 0;
+            else {
+                t *= t;
+                n0 = t * t * GradCoord2D(offset, i, j, x0, y0);
+            }
+
+            t = static_cast<float>(0.5) - x1 * x1 - y1 * y1;
+            if (t < 0) n1 = 0;
+            else {
+                t *= t;
+                n1 = t * t * GradCoord2D(offset, i + i1, j + j1, x1, y1);
+            }
+
+            t = static_cast<float>(0.5) - x2 * x2 - y2 * y2;
+            if (t < 0) n2 = 0;
+            else {
+                t *= t;
+                n2 = t * t * GradCoord2D(offset, i + 1, j + 1, x2, y2);
+            }
+
+            return 70 * (n0 + n1 + n2);
+        }
+
         float get(const unsigned char offset, float x, float y, float z) const {
             float t = (x + y + z) * F3;
             int   i = FastFloor(x + t);
@@ -275,25 +474,27 @@ namespace klangwellen {
             } else if (fSimplexStep < -STEP_LIMIT) {
                 fSimplexStep += STEP_LIMIT;
             }
-            return get(fSimplexStep);
+            return get_1d(0, fSimplexStep);
             // return mSimplexNoise.noise(fSimplexStep, 0.0);
         }
 
     private:
+        static constexpr float F2 = 0.36602540378f; // ( sqrt(3) - 1 ) / 2
+        static constexpr float G2 = 0.21132486540f; // ( 3 - sqrt(3) ) / 6
         static constexpr float F3 = 1 / static_cast<float>(3);
         static constexpr float G3 = 1 / static_cast<float>(6);
 
-        const float GRAD_X[12] =
+        static constexpr float GRAD_X[12] =
             {
                 1, -1, 1, -1,
                 1, -1, 1, -1,
                 0, 0, 0, 0};
-        const float GRAD_Y[12] =
+        static constexpr float GRAD_Y[12] =
             {
                 1, 1, -1, -1,
                 0, 0, 0, 0,
                 1, -1, 1, -1};
-        const float GRAD_Z[12] =
+        static constexpr float GRAD_Z[12] =
             {
                 0, 0, 0, 0,
                 1, 1, -1, -1,
@@ -309,6 +510,18 @@ namespace klangwellen {
             return m_perm12[(x & 0xff) + m_perm[(y & 0xff) + m_perm[(z & 0xff) + offset]]];
         }
 
+        float GradCoord1D(const unsigned char offset, const int x, const float xd) const {
+            /* gradients are -8 ... -1 and 1 ... 8 */
+            const unsigned char mHash     = m_perm[(x & 0xff) + offset];
+            const float         mGradient = static_cast<float>(1 + (mHash & 7));
+            return (mHash & 8) ? -mGradient * xd : mGradient * xd;
+        }
+
+        float GradCoord2D(const unsigned char offset, const int x, const int y, const float xd, const float yd) const {
+            const unsigned char lutPos = m_perm12[(x & 0xff) + m_perm[(y & 0xff) + offset]];
+            return xd * GRAD_X[lutPos] + yd * GRAD_Y[lutPos];
+        }
+
         float GradCoord3D(const unsigned char offset,
                           const int x, const int y, const int z,
                           const float xd, const float yd, const float zd) const {
@@ -319,45 +532,233 @@ namespace klangwellen {
         static int FastFloor(const float f) { return f >= 0 ? static_cast<int>(f) : static_cast<int>(f) - 1; }
     };
 
-    class GaussianWhiteNoise {
+    /**
+     * evaluates many independent 1D simplex noise streams, e.g to modulate a large number of parameters once per block.
+     * each stream has its own position, step size and noise pattern, all streams share the permutation tables of one
+     * `SimplexNoise`. stream states are stored as structure of arrays:
+     * <pre>
+     * <code>
+     *     SimplexNoiseStreams mModulation(256);
+     *     mModulation.set_step(0.001f);
+     *     float mValues[256];
+     *     mModulation.process(mValues); // advance all streams by one step
+     * </code>
+     * </pre>
+     */
+    class SimplexNoiseStreams {
     public:
-        GaussianWhiteNoise() : mPN_b{}, mPN_state{}, mWN_y2(0) {}
+        explicit SimplexNoiseStreams(const uint16_t number_of_streams, const uint32_t seed = 1337)
+            : fNoise(seed),
+              fNumberOfStreams(number_of_streams),
+              fPosition(new float[number_of_streams]),
+              fStep(new float[number_of_streams]),
+              fOffset(new unsigned char[number_of_streams]) {
+            for (uint16_t i = 0; i < fNumberOfStreams; i++) {
+                /* streams beyond 256 patterns are separated by their start position */
+                fOffset[i]   = static_cast<unsigned char>(i);
+                fPosition[i] = static_cast<float>((i >> 8) * 97 % 256);
+                fStep[i]     = 0.01f;
+            }
+        }
+
+        ~SimplexNoiseStreams() {
+            delete[] fPosition;
+            delete[] fStep;
+            delete[] fOffset;
+        }
+
+        SimplexNoiseStreams(const SimplexNoiseStreams&)            = delete;
+        SimplexNoiseStreams& operator=(const SimplexNoiseStreams&) = delete;
+
+        uint16_t get_number_of_streams() const {
+            return fNumberOfStreams;
+        }
+
+        void set_seed(const uint32_t seed) {
+            fNoise.set_seed(seed);
+        }
+
+        /**
+         * sets the step size of all streams
+         */
+        void set_step(const float step) {
+            std::fill_n(fStep, fNumberOfStreams, step);
+        }
+
+        void set_step(const uint16_t stream, const float step) {
+            if (stream < fNumberOfStreams) {
+                fStep[stream] = step;
+            }
+        }
 
+        float get_step(const uint16_t stream) const {
+            return stream < fNumberOfStreams ? fStep[stream] : 0.0f;
+        }
+
+        void set_position(const uint16_t stream, const float position) {
+            if (stream < fNumberOfStreams) {
+                fPosition[stream] = wrap(position);
+            }
+        }
+
+        float get_position(const uint16_t stream) const {
+            return stream < fNumberOfStreams ? fPosition[stream] : 0.0f;
+        }
+
+        /**
+         * advances all streams by one step.
+         *
+         * @param output receives one value per stream ( `get_number_of_streams()` values )
+         */
+        void process(float* output) {
+            for (uint16_t i = 0; i < fNumberOfStreams; i++) {
+                fPosition[i] = wrap(fPosition[i] + fStep[i]);
+                output[i]    = fNoise.get_1d(fOffset[i], fPosition[i]);
+            }
+        }
+
+        /**
+         * advances all streams by `length` steps. the values of each stream are stored consecutively, i.e the value of
+         * stream `s` at step `i` is stored in `output[s * length + i]`.
+         *
+         * @param output receives `get_number_of_streams() * length` values
+         */
+        void process(float* output, const uint32_t length) {
+            for (uint16_t s = 0; s < fNumberOfStreams; s++) {
+                float*              mOutput   = output + s * length;
+                float               mPosition = fPosition[s];
+                const float         mStep     = fStep[s];
+                const unsigned char mOffset   = fOffset[s];
+                for (uint32_t i = 0; i < length; i++) {
+                    mPosition  = wrap(mPosition + mStep);
+                    mOutput[i] = fNoise.get_1d(mOffset, mPosition);
+                }
+                fPosition[s] = mPosition;
+            }
+        }
+
+    private:
+        /* noise repeats every 256 units, wrapping keeps the positions precise */
+        static constexpr float PERIOD = 256.0f;
+
+        SimplexNoise   fNoise;
+        const uint16_t fNumberOfStreams;
+        float*         fPosition;
+        float*         fStep;
+        unsigned char* fOffset;
+
+        static float wrap(float position) {
+            if (position >= PERIOD) {
+                position -= PERIOD;
+            } else if (position < 0.0f) {
+                position += PERIOD;
+            }
+            return position;
+        }
+    };
+
+    /**
+     * gaussian white noise with a standard deviation of 0.5. values are generated with the ziggurat method ( Marsaglia
+     * and Tsang, 2000 ), which needs one random number, one table lookup and one comparison for approx 99% of the
+     * values. logarithms and exponentials are only evaluated in the rare fallback cases. the tables are computed once
+     * and shared by all instances.
+     */
+    class GaussianWhiteNoise {
+    public:
         float process() {
-            // from [Gaussian White Noise](https://www.musicdsp.org/en/latest/Synthesis/109-gaussian-white-noise.html)
-            float y1;
+            return normal(fRandom) * SCALE;
+        }
 
-            if (mWN_pass) {
-                y1 = mWN_y2;
-            } else {
-                float x1;
-                float x2;
-                float w;
-                do {
-                    x1 = 2.0 * KlangWellen::random() - 1.0;
-                    x2 = 2.0 * KlangWellen::random() - 1.0;
-                    w  = x1 * x1 + x2 * x2;
-                } while (w >= 1.0);
-
-                w      = static_cast<float>(sqrt(-2.0 * log(w) / w));
-                y1     = x1 * w;
-                mWN_y2 = x2 * w;
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            const ZigguratTables& mTables = tables();
+            for (uint32_t i = 0; i < buffer_length; i++) {
+                signal_buffer[i] = normal(fRandom, mTables) * SCALE;
             }
-            mWN_pass               = !mWN_pass;
-            constexpr float mScale = 0.5;
-            return y1 * mScale;
+        }
+
+        void set_seed(const uint32_t seed) {
+            fRandom.set_seed(seed);
+        }
+
+        /**
+         * @return normal distributed value with a mean of 0.0 and a standard deviation of 1.0
+         */
+        static float normal(Random& random) {
+            return normal(random, tables());
         }
 
     private:
-        float mPN_b[7];
-        float mPN_state[3];
-        bool  mWN_pass = false;
-        float mWN_y2;
+        static constexpr uint8_t ZIGGURAT_LAYERS = 128;
+        static constexpr float   ZIGGURAT_R      = 3.442619855899f;
+        static constexpr double  ZIGGURAT_AREA   = 9.91256303526217e-3;
+        static constexpr float   SCALE           = 0.5f;
+
+        struct ZigguratTables {
+            uint32_t k[ZIGGURAT_LAYERS];
+            float    w[ZIGGURAT_LAYERS];
+            float    f[ZIGGURAT_LAYERS];
+
+            ZigguratTables() {
+                constexpr double m1 = 2147483648.0;
+                double           dn = ZIGGURAT_R;
+                double           tn = dn;
+                const double     q  = ZIGGURAT_AREA / exp(-0.5 * dn * dn);
+                k[0]                = static_cast<uint32_t>((dn / q) * m1);
+                k[1]                = 0;
+                w[0]                = static_cast<float>(q / m1);
+                w[127]              = static_cast<float>(dn / m1);
+                f[0]                = 1.0f;
+                f[127]              = static_cast<float>(exp(-0.5 * dn * dn));
+                for (uint8_t i = 126; i >= 1; i--) {
+                    dn       = sqrt(-2.0 * log(ZIGGURAT_AREA / dn + exp(-0.5 * dn * dn)));
+                    k[i + 1] = static_cast<uint32_t>((dn / tn) * m1);
+                    tn       = dn;
+                    f[i]     = static_cast<float>(exp(-0.5 * dn * dn));
+                    w[i]     = static_cast<float>(dn / m1);
+                }
+            }
+        };
+
+        static float normal(Random& random, const ZigguratTables& ziggurat) {
+            while (true) {
+                /* the layer and the sign are taken from the high bits ( bits 31-25 and bit 24 ), the low 24 bits are the
+                 * position within the layer ( scaled to 31 bit like the tables ) */
+                const uint32_t mRandom   = random.next();
+                const uint8_t  mLayer    = mRandom >> 25;
+                const bool     mNegative = (mRandom >> 24) & 1;
+                const uint32_t mPosition = (mRandom & 0x00FFFFFF) << 7;
+                const float    mAbsX     = static_cast<float>(mPosition) * ziggurat.w[mLayer];
+                const float    x         = mNegative ? -mAbsX : mAbsX;
+                if (mPosition < ziggurat.k[mLayer]) {
+                    return x;
+                }
+                if (mLayer == 0) {
+                    /* sample from the tail beyond R */
+                    float mTailX;
+                    float mTailY;
+                    do {
+                        mTailX = -logf(1.0f - random.next_normalized()) / ZIGGURAT_R;
+                        mTailY = -logf(1.0f - random.next_normalized());
+                    } while (mTailY + mTailY < mTailX * mTailX);
+                    return mNegative ? -ZIGGURAT_R - mTailX : ZIGGURAT_R + mTailX;
+                }
+                if (ziggurat.f[mLayer] + random.next_normalized() * (ziggurat.f[mLayer - 1] - ziggurat.f[mLayer]) < expf(-0.5f * x * x)) {
+                    return x;
+                }
+            }
+        }
+
+        Random fRandom;
+
+        static const ZigguratTables& tables() {
+            static const ZigguratTables mTables;
+            return mTables;
+        }
     };
 
     class Noise {
         // @TODO( need(!) to understand noise in general and the implementations in detail ( i.e why do the gaussian and
-        //      pink noises sound so different ) better and maybe add some more noise types ( i.e brown, grey ))
+        //      pink noises sound so different ) better )
 
     public:
         Noise() {
@@ -385,10 +786,10 @@ namespace klangwellen {
             float mSignal;
             switch (fType) {
                 case KlangWellen::NOISE_WHITE_FAST:
-                    mSignal = getWhiteNoise();
+                    mSignal = mRandom.next_signed();
                     break;
                 case KlangWellen::NOISE_GAUSSIAN_WHITE_FAST:
-                    mSignal = getGaussianWhiteNoiseFast();
+                    mSignal = GaussianWhiteNoise::normal(mRandom);
                     break;
                 case KlangWellen::NOISE_GAUSSIAN_WHITE:
                     mSignal = mGaussianWhiteNoise.process();
@@ -396,38 +797,101 @@ namespace klangwellen {
                 case KlangWellen::NOISE_PINK:
                     mSignal = mPinkNoise.process();
                     break;
+                case KlangWellen::NOISE_BROWN:
+                    mSignal = mBrownNoise.process();
+                    break;
+                case KlangWellen::NOISE_GREY:
+                    mSignal = mGreyNoise.process();
+                    break;
                 case KlangWellen::NOISE_SIMPLEX:
                     mSignal = mSimplexNoise.process();
                     break;
                 case KlangWellen::NOISE_WHITE:
                 default:
-                    mSignal = getWhiteNoise();
+                    mSignal = mRandom.next_signed();
                     break;
             }
             return mSignal * fAmplitude;
         }
 
+        /**
+         * fills buffer with noise. the noise type is evaluated once per block.
+         */
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            switch (fType) {
+                case KlangWellen::NOISE_GAUSSIAN_WHITE_FAST:
+                    for (uint32_t i = 0; i < buffer_length; i++) {
+                        signal_buffer[i] = GaussianWhiteNoise::normal(mRandom);
+                    }
+                    break;
+                case KlangWellen::NOISE_GAUSSIAN_WHITE:
+                    mGaussianWhiteNoise.process(signal_buffer, buffer_length);
+                    break;
+                case KlangWellen::NOISE_PINK:
+                    mPinkNoise.process(signal_buffer, buffer_length);
+                    break;
+                case KlangWellen::NOISE_BROWN:
+                    mBrownNoise.process(signal_buffer, buffer_length);
+                    break;
+                case KlangWellen::NOISE_GREY:
+                    mGreyNoise.process(signal_buffer, buffer_length);
+                    break;
+                case KlangWellen::NOISE_SIMPLEX:
+                    for (uint32_t i = 0; i < buffer_length; i++) {
+                        signal_buffer[i] = mSimplexNoise.process();
+                    }
+                    break;
+                case KlangWellen::NOISE_WHITE_FAST:
+                case KlangWellen::NOISE_WHITE:
+                default:
+                    mRandom.process(signal_buffer, buffer_length);
+                    break;
+            }
+            if (fAmplitude != 1.0f) {
+                for (uint32_t i = 0; i < buffer_length; i++) {
+                    signal_buffer[i] *= fAmplitude;
+                }
+            }
+        }
+
+        /**
+         * seeds the random number generators of all noise types.
+         */
+        void set_seed(const uint32_t seed) {
+            mRandom.set_seed(seed);
+            mPinkNoise.set_seed(seed + 1);
+            mGaussianWhiteNoise.set_seed(seed + 2);
+            mBrownNoise.set_seed(seed + 3);
+            mGreyNoise.set_seed(seed + 4);
+        }
+
+        /* the static generators use one random number generator per thread ( see `KLANGWELLEN_THREAD_LOCAL` ) */
+
         static float getGaussianWhiteNoiseFast() {
-            // from [Gaussian White Noise](https://www.musicdsp.org/en/latest/Synthesis/113-gaussian-white-noise.html)
-            const float R1 = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-            const float R2 = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-            const float X  = sqrt(-2.0f * log(R1)) * cos(2.0f * PI * R2);
-            return X;
+            return GaussianWhiteNoise::normal(thread_random());
         }
 
         static float getWhiteNoise() {
-            return 2.0f * static_cast<float>(rand()) / static_cast<float>(RAND_MAX) - 1.0;
+            return thread_random().next_signed();
         }
 
         static float getWhiteNoiseFast() {
-            return KlangWellen::random() * 2.0 - 1.0;
+            return thread_random().next_signed();
         }
 
     private:
         float              fAmplitude;
         int                fType;
+        Random             mRandom;
         SimplexNoise       mSimplexNoise;
         PinkNoise          mPinkNoise;
+        BrownNoise         mBrownNoise;
+        GreyNoise          mGreyNoise;
         GaussianWhiteNoise mGaussianWhiteNoise;
+
+        static Random& thread_random() {
+            static KLANGWELLEN_THREAD_LOCAL Random mRandom;
+            return mRandom;
+        }
     };
 } // namespace klangwellen
\ No newline at end of file
@@ -0,0 +1,428 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define KLANGWELLEN_PCM_CONVERSION_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define KLANGWELLEN_PCM_CONVERSION_NEON 1
+#endif
+
+#include "KlangWellen.h"
+
+namespace klangwellen {
+    /**
+     * converts integer PCM samples to float samples and back. the mapping depends on the bit depth:
+     * <ul>
+     * <li>8-bit and 16-bit samples are mapped onto [-1, 1] such that the smallest value maps to -1 and the largest value
+     * maps to 1 ( e.g `-32768 → -1.0` and `32767 → 1.0` ). zero does not map to exactly 0.0.</li>
+     * <li>24-bit and 32-bit samples are scaled by 1/2^(N-1) such that zero maps to 0.0 and the smallest value maps to
+     * -1 while the largest value maps to slightly less than 1 ( e.g `8388607 → 1.0 - 2^-23` ). this keeps float samples
+     * exact when they are converted to 24 bit and back.</li>
+     * </ul>
+     * float samples are rounded half to even when they are converted to integer samples.
+     * <p>
+     * the block functions use SSE2 ( x86 ) or NEON ( ARM64 ) for 16-bit and 32-bit samples where available and fall
+     * back to plain loops otherwise. `decode` and `encode` convert raw byte streams in one of the `KlangWellen::SIG_*`
+     * formats ( e.g as stored in WAV or AIFF files ).
+     */
+    class PCMConversion {
+    public:
+        /* single samples */
+
+        static float to_float(const uint8_t sample) {
+            return sample * SCALE_8BIT - 1.0f;
+        }
+
+        static float to_float(const int8_t sample) {
+            return sample * SCALE_8BIT + OFFSET_8BIT;
+        }
+
+        static float to_float(const uint16_t sample) {
+            return sample * SCALE_16BIT - 1.0f;
+        }
+
+        static float to_float(const int16_t sample) {
+            return sample * SCALE_16BIT + OFFSET_16BIT;
+        }
+
+        /**
+         * @param sample 24-bit sample sign extended to 32 bit
+         */
+        static float int24_to_float(const int32_t sample) {
+            return sample * SCALE_24BIT;
+        }
+
+        static float to_float(const int32_t sample) {
+            return sample * SCALE_32BIT;
+        }
+
+        static uint8_t to_uint8(const float sample) {
+            return static_cast<uint8_t>(clamp_round((sample + 1.0f) * 127.5f, 0.0f, 255.0f));
+        }
+
+        static int8_t to_int8(const float sample) {
+            return static_cast<int8_t>(clamp_round(sample * 127.5f - 0.5f, -128.0f, 127.0f));
+        }
+
+        static uint16_t to_uint16(const float sample) {
+            return static_cast<uint16_t>(clamp_round((sample + 1.0f) * 32767.5f, 0.0f, 65535.0f));
+        }
+
+        static int16_t to_int16(const float sample) {
+            return static_cast<int16_t>(clamp_round(sample * 32767.5f - 0.5f, -32768.0f, 32767.0f));
+        }
+
+        static int32_t to_int24(const float sample) {
+            return static_cast<int32_t>(clamp_round(sample * 8388608.0f, -8388608.0f, 8388607.0f));
+        }
+
+        static int32_t to_int32(const float sample) {
+            /* 2147483647 is not representable as float, values are clamped in double precision */
+            const double mSample = static_cast<double>(sample) * 2147483648.0;
+            if (mSample >= 2147483647.0) {
+                return 2147483647;
+            }
+            if (mSample <= -2147483648.0) {
+                return -2147483647 - 1;
+            }
+            return static_cast<int32_t>(lrint(mSample));
+        }
+
+        /* blocks */
+
+        static void to_float(const uint8_t* samples, float* output, const uint32_t length) {
+            for (uint32_t i = 0; i < length; i++) {
+                output[i] = to_float(samples[i]);
+            }
+        }
+
+        static void to_float(const int8_t* samples, float* output, const uint32_t length) {
+            for (uint32_t i = 0; i < length; i++) {
+                output[i] = to_float(samples[i]);
+            }
+        }
+
+        static void to_float(const uint16_t* samples, float* output, const uint32_t length) {
+            for (uint32_t i = 0; i < length; i++) {
+                output[i] = to_float(samples[i]);
+            }
+        }
+
+        static void to_float(const int16_t* samples, float* output, const uint32_t length) {
+            uint32_t i = 0;
+#if defined(KLANGWELLEN_PCM_CONVERSION_SSE2)
+            const __m128 mScale  = _mm_set1_ps(SCALE_16BIT);
+            const __m128 mOffset = _mm_set1_ps(OFFSET_16BIT);
+            for (; i + 8 <= length; i += 8) {
+                const __m128i mSamples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+                const __m128i mLow     = _mm_srai_epi32(_mm_unpacklo_epi16(mSamples, mSamples), 16);
+                const __m128i mHigh    = _mm_srai_epi32(_mm_unpackhi_epi16(mSamples, mSamples), 16);
+                _mm_storeu_ps(output + i, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(mLow), mScale), mOffset));
+                _mm_storeu_ps(output + i + 4, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(mHigh), mScale), mOffset));
+            }
+#elif defined(KLANGWELLEN_PCM_CONVERSION_NEON)
+            const float32x4_t mOffset = vdupq_n_f32(OFFSET_16BIT);
+            for (; i + 8 <= length; i += 8) {
+                const int16x8_t   mSamples = vld1q_s16(samples + i);
+                const float32x4_t mLow     = vcvtq_f32_s32(vmovl_s16(vget_low_s16(mSamples)));
+                const float32x4_t mHigh    = vcvtq_f32_s32(vmovl_s16(vget_high_s16(mSamples)));
+                vst1q_f32(output + i, vmlaq_n_f32(mOffset, mLow, SCALE_16BIT));
+                vst1q_f32(output + i + 4, vmlaq_n_f32(mOffset, mHigh, SCALE_16BIT));
+            }
+#endif
+            for (; i < length; i++) {
+                output[i] = to_float(samples[i]);
+            }
+        }
+
+        static void to_float(const int32_t* samples, float* output, const uint32_t length) {
+            uint32_t i = 0;
+#if defined(KLANGWELLEN_PCM_CONVERSION_SSE2)
+            const __m128 mScale = _mm_set1_ps(SCALE_32BIT);
+            for (; i + 4 <= length; i += 4) {
+                const __m128i mSamples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+                _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(mSamples), mScale));
+            }
+#elif defined(KLANGWELLEN_PCM_CONVERSION_NEON)
+            for (; i + 4 <= length; i += 4) {
+                vst1q_f32(output + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(samples + i)), SCALE_32BIT));
+            }
+#endif
+            for (; i < length; i++) {
+                output[i] = to_float(samples[i]);
+            }
+        }
+
+        static void from_float(const float* samples, uint8_t* output, const uint32_t length) {
+            for (uint32_t i = 0; i < length; i++) {
+                output[i] = to_uint8(samples[i]);
+            }
+        }
+
+        static void from_float(const float* samples, int8_t* output, const uint32_t length) {
+            for (uint32_t i = 0; i < length; i++) {
+                output[i] = to_int8(samples[i]);
+            }
+        }
+
+        static void from_float(const float* samples, uint16_t* output, const uint32_t length) {
+            for (uint32_t i = 0; i < length; i++) {
+                output[i] = to_uint16(samples[i]);
+            }
+        }
+
+        static void from_float(const float* samples, int16_t* output, const uint32_t length) {
+            uint32_t i = 0;
+#if defined(KLANGWELLEN_PCM_CONVERSION_SSE2)
+            /* `_mm_cvtps_epi32` rounds half to even, `_mm_packs_epi32` saturates to the 16-bit range */
+            const __m128 mScale  = _mm_set1_ps(32767.5f);
+            const __m128 mOffset = _mm_set1_ps(-0.5f);
+            for (; i + 8 <= length; i += 8) {
+                const __m128i mLow  = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(samples + i), mScale), mOffset));
+                const __m128i mHigh = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(samples + i + 4), mScale), mOffset));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(mLow, mHigh));
+            }
+#elif defined(KLANGWELLEN_PCM_CONVERSION_NEON)
+            const float32x4_t mOffset = vdupq_n_f32(-0.5f);
+            for (; i + 8 <= length; i += 8) {
+                const int32x4_t mLow  = vcvtnq_s32_f32(vmlaq_n_f32(mOffset, vld1q_f32(samples + i), 32767.5f));
+                const int32x4_t mHigh = vcvtnq_s32_f32(vmlaq_n_f32(mOffset, vld1q_f32(samples + i + 4), 32767.5f));
+                vst1q_s16(output + i, vcombine_s16(vqmovn_s32(mLow), vqmovn_s32(mHigh)));
+            }
+#endif
+            for (; i < length; i++) {
+                output[i] = to_int16(samples[i]);
+            }
+        }
+
+        static void from_float(const float* samples, int32_t* output, const uint32_t length) {
+            for (uint32_t i = 0; i < length; i++) {
+                output[i] = to_int32(samples[i]);
+            }
+        }
+
+        /* raw byte streams */
+
+        /**
+         * @return number of bytes per sample of a `KlangWellen::SIG_*` format or 0 if the format is unknown
+         */
+        static uint8_t bytes_per_sample(const uint8_t format) {
+            switch (format) {
+                case KlangWellen::SIG_INT8:
+                case KlangWellen::SIG_UINT8:
+                    return 1;
+                case KlangWellen::SIG_INT16_BIG_ENDIAN:
+                case KlangWellen::SIG_INT16_LITTLE_ENDIAN:
+                    return 2;
+                case KlangWellen::SIG_INT24_3_BIG_ENDIAN:
+                case KlangWellen::SIG_INT24_3_LITTLE_ENDIAN:
+                    return 3;
+                case KlangWellen::SIG_INT24_4_BIG_ENDIAN:
+                case KlangWellen::SIG_INT24_4_LITTLE_ENDIAN:
+                case KlangWellen::SIG_INT32_BIG_ENDIAN:
+                case KlangWellen::SIG_INT32_LITTLE_ENDIAN:
+                    return 4;
+                default:
+                    return 0;
+            }
+        }
+
+        /**
+         * converts raw sample data to float samples.
+         *
+         * @param data   raw sample data
+         * @param output float samples
+         * @param length number of samples to convert
+         * @param format sample format of raw data as one of the `KlangWellen::SIG_*` constants. 24-bit samples in 4
+         *               bytes ( `SIG_INT24_4_*` ) are expected to occupy the least significant bytes.
+         * @param stride distance between two consecutive samples in samples ( e.g number of channels of interleaved data )
+         * @return true if the format is supported
+         */
+        static bool decode(const uint8_t* data,
+                           float*         output,
+                           const uint32_t length,
+                           const uint8_t  format,
+                           const uint16_t stride = 1) {
+            const uint8_t mBytesPerSample = bytes_per_sample(format);
+            if (mBytesPerSample == 0) {
+                return false;
+            }
+            if (stride == 1 && decode_native(data, output, length, format)) {
+                return true;
+            }
+            const uint32_t mStep = mBytesPerSample * stride;
+            for (uint32_t i = 0; i < length; i++) {
+                const uint8_t* p = data + i * mStep;
+                switch (format) {
+                    case KlangWellen::SIG_UINT8:
+                        output[i] = to_float(p[0]);
+                        break;
+                    case KlangWellen::SIG_INT8:
+                        output[i] = to_float(static_cast<int8_t>(p[0]));
+                        break;
+                    case KlangWellen::SIG_INT16_LITTLE_ENDIAN:
+                        output[i] = to_float(static_cast<int16_t>(p[0] | (p[1] << 8)));
+                        break;
+                    case KlangWellen::SIG_INT16_BIG_ENDIAN:
+                        output[i] = to_float(static_cast<int16_t>((p[0] << 8) | p[1]));
+                        break;
+                    case KlangWellen::SIG_INT24_3_LITTLE_ENDIAN:
+                    case KlangWellen::SIG_INT24_4_LITTLE_ENDIAN:
+                        output[i] = int24_to_float(sign_extend_24(p[0] | (p[1] << 8) | (p[2] << 16)));
+                        break;
+                    case KlangWellen::SIG_INT24_3_BIG_ENDIAN:
+                        output[i] = int24_to_float(sign_extend_24((p[0] << 16) | (p[1] << 8) | p[2]));
+                        break;
+                    case KlangWellen::SIG_INT24_4_BIG_ENDIAN:
+                        output[i] = int24_to_float(sign_extend_24((p[1] << 16) | (p[2] << 8) | p[3]));
+                        break;
+                    case KlangWellen::SIG_INT32_LITTLE_ENDIAN:
+                        output[i] = to_float(static_cast<int32_t>(p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24)));
+                        break;
+                    case KlangWellen::SIG_INT32_BIG_ENDIAN:
+                        output[i] = to_float(static_cast<int32_t>(p[3] | (p[2] << 8) | (p[1] << 16) | (static_cast<uint32_t>(p[0]) << 24)));
+                        break;
+                    default:
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * converts float samples to raw sample data.
+         *
+         * @param samples float samples
+         * @param data    raw sample data
+         * @param length  number of samples to convert
+         * @param format  sample format of raw data as one of the `KlangWellen::SIG_*` constants
+         * @return true if the format is supported
+         */
+        static bool encode(const float* samples, uint8_t* data, const uint32_t length, const uint8_t format) {
+            if (bytes_per_sample(format) == 0) {
+                return false;
+            }
+            if (encode_native(samples, data, length, format)) {
+                return true;
+            }
+            for (uint32_t i = 0; i < length; i++) {
+                switch (format) {
+                    case KlangWellen::SIG_UINT8:
+                        data[i] = to_uint8(samples[i]);
+                        break;
+                    case KlangWellen::SIG_INT8:
+                        data[i] = static_cast<uint8_t>(to_int8(samples[i]));
+                        break;
+                    case KlangWellen::SIG_INT16_LITTLE_ENDIAN:
+                    case KlangWellen::SIG_INT16_BIG_ENDIAN:
+                        write_bytes(data + i * 2, static_cast<uint16_t>(to_int16(samples[i])), 2, format == KlangWellen::SIG_INT16_BIG_ENDIAN);
+                        break;
+                    case KlangWellen::SIG_INT24_3_LITTLE_ENDIAN:
+                    case KlangWellen::SIG_INT24_3_BIG_ENDIAN:
+                        write_bytes(data + i * 3, static_cast<uint32_t>(to_int24(samples[i])), 3, format == KlangWellen::SIG_INT24_3_BIG_ENDIAN);
+                        break;
+                    case KlangWellen::SIG_INT24_4_LITTLE_ENDIAN:
+                        write_bytes(data + i * 4, static_cast<uint32_t>(to_int24(samples[i])), 4, false);
+                        break;
+                    case KlangWellen::SIG_INT24_4_BIG_ENDIAN:
+                        write_bytes(data + i * 4, static_cast<uint32_t>(to_int24(samples[i])), 4, true);
+                        break;
+                    case KlangWellen::SIG_INT32_LITTLE_ENDIAN:
+                    case KlangWellen::SIG_INT32_BIG_ENDIAN:
+                        write_bytes(data + i * 4, static_cast<uint32_t>(to_int32(samples[i])), 4, format == KlangWellen::SIG_INT32_BIG_ENDIAN);
+                        break;
+                    default:
+                        return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        static constexpr float SCALE_8BIT   = 2.0f / 255.0f;
+        static constexpr float OFFSET_8BIT  = 1.0f / 255.0f;
+        static constexpr float SCALE_16BIT  = 2.0f / 65535.0f;
+        static constexpr float OFFSET_16BIT = 1.0f / 65535.0f;
+        static constexpr float SCALE_24BIT  = 1.0f / 8388608.0f;
+        static constexpr float SCALE_32BIT  = 1.0f / 2147483648.0f;
+
+        /* rounds half to even like the SIMD conversions ( `_mm_cvtps_epi32` and `vcvtnq_s32_f32` ) */
+        static float clamp_round(const float value, const float min, const float max) {
+            return value < min ? min : (value > max ? max : nearbyintf(value));
+        }
+
+        static int32_t sign_extend_24(const int32_t value) {
+            return static_cast<int32_t>(static_cast<uint32_t>(value) << 8) >> 8;
+        }
+
+        static bool is_native_16bit(const uint8_t format) {
+            return format == (KlangWellen::is_host_little_endian() ? KlangWellen::SIG_INT16_LITTLE_ENDIAN : KlangWellen::SIG_INT16_BIG_ENDIAN);
+        }
+
+        static bool is_native_32bit(const uint8_t format) {
+            return format == (KlangWellen::is_host_little_endian() ? KlangWellen::SIG_INT32_LITTLE_ENDIAN : KlangWellen::SIG_INT32_BIG_ENDIAN);
+        }
+
+        /* uses the block functions if raw data is densely packed in host byte order and suitably aligned */
+        static bool decode_native(const uint8_t* data, float* output, const uint32_t length, const uint8_t format) {
+            if (format == KlangWellen::SIG_UINT8) {
+                to_float(data, output, length);
+                return true;
+            }
+            if (format == KlangWellen::SIG_INT8) {
+                to_float(reinterpret_cast<const int8_t*>(data), output, length);
+                return true;
+            }
+            if (is_native_16bit(format) && reinterpret_cast<uintptr_t>(data) % alignof(int16_t) == 0) {
+                to_float(reinterpret_cast<const int16_t*>(data), output, length);
+                return true;
+            }
+            if (is_native_32bit(format) && reinterpret_cast<uintptr_t>(data) % alignof(int32_t) == 0) {
+                to_float(reinterpret_cast<const int32_t*>(data), output, length);
+                return true;
+            }
+            return false;
+        }
+
+        static bool encode_native(const float* samples, uint8_t* data, const uint32_t length, const uint8_t format) {
+            if (is_native_16bit(format) && reinterpret_cast<uintptr_t>(data) % alignof(int16_t) == 0) {
+                from_float(samples, reinterpret_cast<int16_t*>(data), length);
+                return true;
+            }
+            if (is_native_32bit(format) && reinterpret_cast<uintptr_t>(data) % alignof(int32_t) == 0) {
+                from_float(samples, reinterpret_cast<int32_t*>(data), length);
+                return true;
+            }
+            return false;
+        }
+
+        static void write_bytes(uint8_t* data, const uint32_t value, const uint8_t number_of_bytes, const bool big_endian) {
+            for (uint8_t i = 0; i < number_of_bytes; i++) {
+                data[big_endian ? number_of_bytes - 1 - i : i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+    };
+} // namespace klangwellen
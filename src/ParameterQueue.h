@@ -0,0 +1,138 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "SPSCRingBuffer.h"
+
+namespace klangwellen {
+    /**
+     * wait-free queue of parameter changes for a processor. a control thread ( e.g a UI ) pushes changes, the audio
+     * thread applies all pending changes at the start of each block. this way setters are never called concurrently
+     * with `process()`:
+     * <pre>
+     * <code>
+     *     ParameterQueue<Wavetable> mQueue;
+     *     // control thread
+     *     mQueue.push<&Wavetable::set_frequency>(440.0f);
+     *     // audio thread, at the start of each block
+     *     mQueue.apply(mWavetable);
+     *     mWavetable.process(mBuffer, 128);
+     * </code>
+     * </pre>
+     * values that are expensive to compute ( e.g filter coefficients ) should be computed on the control thread and
+     * pushed as a whole, so that the audio thread only copies them ( see `Filter::compute_coefficients()` or
+     * `Vocoder::compute_formant_coefficients()` ). every slot of the queue holds a value, so queues for large values
+     * should have a small capacity ( e.g 2 ):
+     * <pre>
+     * <code>
+     *     ParameterQueue<Filter, Filter::Coefficients> mQueue(2);
+     *     Filter::Coefficients                         mCoefficients;
+     *     mFilter.compute_coefficients(Filter::LPF, 0.0f, 800.0f, 1.0f, mCoefficients);
+     *     mQueue.push<&Filter::set_coefficients>(mCoefficients);
+     * </code>
+     * </pre>
+     * like `SPSCRingBuffer` the queue supports exactly one producer and one consumer thread.
+     */
+    template<typename PROCESSOR, typename VALUE = float>
+    class ParameterQueue {
+    public:
+        using Function = void (*)(PROCESSOR&, const VALUE&);
+
+        explicit ParameterQueue(const uint32_t capacity = 64) : _changes(capacity) {}
+
+        /**
+         * queues a call of a setter that takes the value by value ( e.g `Reverb::set_roomsize(float)` ). may only be
+         * called from the producer thread.
+         *
+         * @return false if the queue is full
+         */
+        template<void (PROCESSOR::*SETTER)(VALUE)>
+        bool push(const VALUE& value) {
+            return push(&call_setter<SETTER>, value);
+        }
+
+        /**
+         * queues a call of a setter that takes the value by reference ( e.g `Filter::set_coefficients(const
+         * Coefficients&)` ). may only be called from the producer thread.
+         *
+         * @return false if the queue is full
+         */
+        template<void (PROCESSOR::*SETTER)(const VALUE&)>
+        bool push(const VALUE& value) {
+            return push(&call_setter_reference<SETTER>, value);
+        }
+
+        /**
+         * queues a call of a function ( e.g a lambda without captures ) that applies the value to the processor. may only
+         * be called from the producer thread.
+         *
+         * @return false if the queue is full
+         */
+        bool push(const Function function, const VALUE& value) {
+            Change mChange;
+            mChange.function = function;
+            mChange.value    = value;
+            return _changes.push(mChange);
+        }
+
+        /**
+         * applies all pending changes in the order they were pushed. may only be called from the consumer thread,
+         * usually the audio thread at the start of a block.
+         *
+         * @return number of applied changes
+         */
+        uint32_t apply(PROCESSOR& processor) {
+            uint32_t mApplied = 0;
+            Change   mChange;
+            while (_changes.pop(mChange)) {
+                mChange.function(processor, mChange.value);
+                mApplied++;
+            }
+            return mApplied;
+        }
+
+        /**
+         * @return number of pending changes. may only be called from the consumer thread.
+         */
+        uint32_t get_number_of_pending_changes() const {
+            return _changes.available_to_read();
+        }
+
+    private:
+        struct Change {
+            Function function = nullptr;
+            VALUE    value{};
+        };
+
+        SPSCRingBuffer<Change> _changes;
+
+        template<void (PROCESSOR::*SETTER)(VALUE)>
+        static void call_setter(PROCESSOR& processor, const VALUE& value) {
+            (processor.*SETTER)(value);
+        }
+
+        template<void (PROCESSOR::*SETTER)(const VALUE&)>
+        static void call_setter_reference(PROCESSOR& processor, const VALUE& value) {
+            (processor.*SETTER)(value);
+        }
+    };
+} // namespace klangwellen
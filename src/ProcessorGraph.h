@@ -0,0 +1,424 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * PROCESSOR INTERFACE
+ *
+ * - [ ] float process()
+ * - [ ] float process(float)
+ * - [ ] void process(AudioSignal&)
+ * - [x] void process(float*, uint32_t) *overwrite*
+ * - [ ] void process(float*, float*, uint32_t)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Chain.h"
+
+namespace klangwellen {
+    /**
+     * graph of processors that can be edited while it is being processed. each node wraps a processor ( or any
+     * processor-like object like a `Chain` ) that processes a mono block in place. the inputs of a node are summed
+     * before the node is processed. a node without a processor only sums its inputs ( i.e a mixer ):
+     * <pre>
+     * <code>
+     *     ProcessorGraph mGraph;
+     *     const uint16_t mWavetableNode = mGraph.add_node(mWavetable);
+     *     const uint16_t mFilterNode    = mGraph.add_node(mFilter);
+     *     const uint16_t mSamplerNode   = mGraph.add_node(mSampler);
+     *     const uint16_t mMixerNode     = mGraph.add_node();
+     *     mGraph.connect(mWavetableNode, mFilterNode);
+     *     mGraph.connect(mFilterNode, mMixerNode);
+     *     mGraph.connect(mSamplerNode, mMixerNode);
+     *     mGraph.set_output(mMixerNode);
+     *     mGraph.commit();              // control thread
+     *     mGraph.process(mBuffer, 128); // audio thread
+     * </code>
+     * </pre>
+     * editing the graph ( i.e `add_node`, `connect`, … ) does not affect processing until `commit()` is called.
+     * `commit()` sorts the nodes topologically and assigns the block buffers from a pool: the output of a node is summed
+     * into its consumers right after it is processed, so buffers are returned to the pool early and a chain of nodes
+     * processes a single buffer in place. the schedule is then swapped in atomically, `process()` never blocks or
+     * allocates.
+     *
+     * editing and `commit()` must happen on one thread ( e.g the UI thread ), `process()` on another ( e.g the audio
+     * thread ). processors must stay alive until the `commit()` that removes them has returned.
+     */
+    class ProcessorGraph {
+    public:
+        using ProcessFunction = void (*)(void* processor, float* signal_buffer, uint32_t length);
+
+        static constexpr uint16_t NO_NODE                  = 0xFFFF;
+        static constexpr uint32_t DEFAULT_MAX_BLOCK_LENGTH = 256;
+
+        explicit ProcessorGraph(const uint32_t max_block_length = DEFAULT_MAX_BLOCK_LENGTH) : _max_block_length(std::max(max_block_length, static_cast<uint32_t>(1))) {}
+
+        ~ProcessorGraph() {
+            delete _schedule.load();
+        }
+
+        ProcessorGraph(const ProcessorGraph&)            = delete;
+        ProcessorGraph& operator=(const ProcessorGraph&) = delete;
+
+        /**
+         * adds a node that processes the block with the processor. processors without a block `process` method are
+         * processed sample by sample ( see `Chain` ).
+         *
+         * @return id of the node
+         */
+        template<typename PROCESSOR>
+        uint16_t add_node(PROCESSOR& processor) {
+            return add_node(&process_processor<PROCESSOR>, &processor);
+        }
+
+        /**
+         * adds a node that calls `function(processor, signal_buffer, length)`. if `function` is `nullptr` the node only
+         * sums its inputs.
+         *
+         * @return id of the node or `NO_NODE` if the graph is full
+         */
+        uint16_t add_node(const ProcessFunction function = nullptr, void* processor = nullptr) {
+            uint16_t mID = NO_NODE;
+            for (uint16_t i = 0; i < _nodes.size(); i++) {
+                if (!_nodes[i].used) {
+                    mID = i;
+                    break;
+                }
+            }
+            if (mID == NO_NODE) {
+                if (_nodes.size() >= NO_NODE) {
+                    return NO_NODE;
+                }
+                mID = static_cast<uint16_t>(_nodes.size());
+                _nodes.emplace_back();
+            }
+            Node& mNode     = _nodes[mID];
+            mNode.used      = true;
+            mNode.function  = function;
+            mNode.processor = processor;
+            mNode.inputs.clear();
+            return mID;
+        }
+
+        /**
+         * removes a node and all its connections. the id may be reused by the next node that is added.
+         */
+        bool remove_node(const uint16_t node) {
+            if (!is_node(node)) {
+                return false;
+            }
+            for (Node& mNode: _nodes) {
+                mNode.inputs.erase(std::remove(mNode.inputs.begin(), mNode.inputs.end(), node), mNode.inputs.end());
+            }
+            _nodes[node].used = false;
+            _nodes[node].inputs.clear();
+            if (_output == node) {
+                _output = NO_NODE;
+            }
+            return true;
+        }
+
+        /**
+         * connects the output of node `from` to the input of node `to`. cycles are only detected in `commit()`.
+         *
+         * @return false if one of the nodes does not exist or the nodes are already connected
+         */
+        bool connect(const uint16_t from, const uint16_t to) {
+            if (!is_node(from) || !is_node(to) || from == to || is_connected(from, to)) {
+                return false;
+            }
+            _nodes[to].inputs.push_back(from);
+            return true;
+        }
+
+        bool disconnect(const uint16_t from, const uint16_t to) {
+            if (!is_connected(from, to)) {
+                return false;
+            }
+            std::vector<uint16_t>& mInputs = _nodes[to].inputs;
+            mInputs.erase(std::find(mInputs.begin(), mInputs.end(), from));
+            return true;
+        }
+
+        bool is_connected(const uint16_t from, const uint16_t to) const {
+            if (!is_node(from) || !is_node(to)) {
+                return false;
+            }
+            const std::vector<uint16_t>& mInputs = _nodes[to].inputs;
+            return std::find(mInputs.begin(), mInputs.end(), from) != mInputs.end();
+        }
+
+        bool is_node(const uint16_t node) const {
+            return node < _nodes.size() && _nodes[node].used;
+        }
+
+        /**
+         * sets the node that is written to the buffer in `process()`. only nodes that the output depends on are processed.
+         */
+        bool set_output(const uint16_t node) {
+            if (!is_node(node)) {
+                return false;
+            }
+            _output = node;
+            return true;
+        }
+
+        uint16_t get_output() const {
+            return _output;
+        }
+
+        /**
+         * compiles the graph into a schedule and swaps it with the schedule that is currently processed. waits until
+         * `process()` has finished with the previous schedule before releasing it.
+         *
+         * @return false if the graph contains a cycle, the current schedule is kept in that case
+         */
+        bool commit() {
+            Schedule* mSchedule = new Schedule();
+            if (!compile(*mSchedule)) {
+                delete mSchedule;
+                return false;
+            }
+            Schedule* mPrevious = _schedule.exchange(mSchedule);
+            while (_schedule_in_use.load() == mPrevious && mPrevious != nullptr) {
+                std::this_thread::yield();
+            }
+            delete mPrevious;
+            return true;
+        }
+
+        /**
+         * @return number of nodes processed per block in the current schedule. may only be called from the thread that
+         * calls `commit()`.
+         */
+        uint32_t get_number_of_scheduled_nodes() const {
+            const Schedule* mSchedule = _schedule.load();
+            return mSchedule == nullptr ? 0 : static_cast<uint32_t>(mSchedule->steps.size());
+        }
+
+        /**
+         * @return number of block buffers allocated by the current schedule. may only be called from the thread that
+         * calls `commit()`.
+         */
+        uint32_t get_number_of_buffers() const {
+            const Schedule* mSchedule = _schedule.load();
+            return mSchedule == nullptr ? 0 : mSchedule->number_of_buffers;
+        }
+
+        /**
+         * processes the graph and writes the output node to the buffer. writes silence if no schedule has been
+         * committed or the graph has no output.
+         */
+        void process(float* signal_buffer, const uint32_t length) {
+            Schedule* mSchedule;
+            do {
+                mSchedule = _schedule.load();
+                _schedule_in_use.store(mSchedule);
+            } while (mSchedule != _schedule.load());
+
+            if (mSchedule == nullptr || mSchedule->output_buffer == NO_BUFFER) {
+                std::fill_n(signal_buffer, length, 0.0f);
+            } else {
+                for (uint32_t i = 0; i < length; i += _max_block_length) {
+                    process_schedule(*mSchedule, signal_buffer + i, std::min(_max_block_length, length - i));
+                }
+            }
+            _schedule_in_use.store(nullptr);
+        }
+
+    private:
+        static constexpr uint16_t NO_BUFFER = 0xFFFF;
+
+        struct Node {
+            bool                  used      = false;
+            ProcessFunction       function  = nullptr;
+            void*                 processor = nullptr;
+            std::vector<uint16_t> inputs;
+        };
+
+        struct Transfer {
+            uint16_t buffer;
+            bool     add; /* add to `buffer` instead of copying */
+        };
+
+        struct Step {
+            ProcessFunction function;
+            void*           processor;
+            uint16_t        buffer;
+            bool            clear; /* node has no inputs */
+            uint32_t        first_transfer;
+            uint32_t        number_of_transfers;
+        };
+
+        struct Schedule {
+            std::vector<Step>     steps;
+            std::vector<Transfer> transfers;
+            std::vector<float>    buffers;
+            uint16_t              number_of_buffers = 0;
+            uint16_t              output_buffer     = NO_BUFFER;
+        };
+
+        const uint32_t         _max_block_length;
+        std::vector<Node>      _nodes;
+        uint16_t               _output = NO_NODE;
+        std::atomic<Schedule*> _schedule{nullptr};
+        std::atomic<Schedule*> _schedule_in_use{nullptr};
+
+        template<typename PROCESSOR>
+        static void process_processor(void* processor, float* signal_buffer, const uint32_t length) {
+            Chain<PROCESSOR> mChain(*static_cast<PROCESSOR*>(processor));
+            mChain.process_blocks(signal_buffer, length);
+        }
+
+        float* buffer(Schedule& schedule, const uint16_t buffer) const {
+            return schedule.buffers.data() + static_cast<size_t>(buffer) * _max_block_length;
+        }
+
+        void process_schedule(Schedule& schedule, float* signal_buffer, const uint32_t length) const {
+            for (const Step& mStep: schedule.steps) {
+                float* mBuffer = buffer(schedule, mStep.buffer);
+                if (mStep.clear) {
+                    std::fill_n(mBuffer, length, 0.0f);
+                }
+                if (mStep.function != nullptr) {
+                    mStep.function(mStep.processor, mBuffer, length);
+                }
+                for (uint32_t j = 0; j < mStep.number_of_transfers; j++) {
+                    const Transfer& mTransfer = schedule.transfers[mStep.first_transfer + j];
+                    float*          mTarget   = buffer(schedule, mTransfer.buffer);
+                    if (mTransfer.add) {
+                        for (uint32_t i = 0; i < length; i++) {
+                            mTarget[i] += mBuffer[i];
+                        }
+                    } else {
+                        memcpy(mTarget, mBuffer, length * sizeof(float));
+                    }
+                }
+            }
+            memcpy(signal_buffer, buffer(schedule, schedule.output_buffer), length * sizeof(float));
+        }
+
+        /*
+         * sorts the nodes the output depends on topologically ( Kahn's algorithm ) and assigns buffers. the output of a
+         * node is summed into the buffers of its consumers right after the node is processed, so a buffer is only in use
+         * from the first input of a node until the node is processed. the buffer of a node is handed on to the first
+         * consumer that has no buffer yet instead of copying it.
+         */
+        bool compile(Schedule& schedule) const {
+            if (_output == NO_NODE) {
+                return true;
+            }
+
+            /* collect nodes the output depends on */
+            std::vector<bool>     mRequired(_nodes.size(), false);
+            std::vector<uint16_t> mStack{_output};
+            mRequired[_output] = true;
+            while (!mStack.empty()) {
+                const uint16_t mNode = mStack.back();
+                mStack.pop_back();
+                for (const uint16_t mInput: _nodes[mNode].inputs) {
+                    if (!mRequired[mInput]) {
+                        mRequired[mInput] = true;
+                        mStack.push_back(mInput);
+                    }
+                }
+            }
+
+            /* collect consumers and count pending inputs */
+            std::vector<std::vector<uint16_t>> mConsumers(_nodes.size());
+            std::vector<uint16_t>              mPendingInputs(_nodes.size(), 0);
+            std::vector<uint16_t>              mReady;
+            uint32_t                           mNumberOfRequiredNodes = 0;
+            for (uint16_t i = 0; i < _nodes.size(); i++) {
+                if (!mRequired[i]) {
+                    continue;
+                }
+                mNumberOfRequiredNodes++;
+                mPendingInputs[i] = static_cast<uint16_t>(_nodes[i].inputs.size());
+                for (const uint16_t mInput: _nodes[i].inputs) {
+                    mConsumers[mInput].push_back(i);
+                }
+                if (mPendingInputs[i] == 0) {
+                    mReady.push_back(i);
+                }
+            }
+
+            std::vector<uint16_t> mNodeBuffer(_nodes.size(), NO_BUFFER);
+            std::vector<uint16_t> mFreeBuffers;
+            auto                  allocate_buffer = [&]() -> uint16_t {
+                if (mFreeBuffers.empty()) {
+                    return schedule.number_of_buffers++;
+                }
+                const uint16_t mBuffer = mFreeBuffers.back();
+                mFreeBuffers.pop_back();
+                return mBuffer;
+            };
+
+            while (!mReady.empty()) {
+                const uint16_t mNode = mReady.back();
+                mReady.pop_back();
+
+                Step mStep;
+                mStep.function       = _nodes[mNode].function;
+                mStep.processor      = _nodes[mNode].processor;
+                mStep.clear          = mNodeBuffer[mNode] == NO_BUFFER;
+                mStep.buffer         = mStep.clear ? allocate_buffer() : mNodeBuffer[mNode];
+                mStep.first_transfer = static_cast<uint32_t>(schedule.transfers.size());
+
+                bool mHandedOn = false;
+                for (const uint16_t mConsumer: mConsumers[mNode]) {
+                    if (mNodeBuffer[mConsumer] != NO_BUFFER) {
+                        schedule.transfers.push_back({mNodeBuffer[mConsumer], true});
+                    } else if (!mHandedOn) {
+                        mNodeBuffer[mConsumer] = mStep.buffer;
+                        mHandedOn              = true;
+                    } else {
+                        mNodeBuffer[mConsumer] = allocate_buffer();
+                        schedule.transfers.push_back({mNodeBuffer[mConsumer], false});
+                    }
+                    if (--mPendingInputs[mConsumer] == 0) {
+                        mReady.push_back(mConsumer);
+                    }
+                }
+                mStep.number_of_transfers = static_cast<uint32_t>(schedule.transfers.size()) - mStep.first_transfer;
+                schedule.steps.push_back(mStep);
+
+                if (mNode == _output) {
+                    schedule.output_buffer = mStep.buffer;
+                } else if (!mHandedOn) {
+                    mFreeBuffers.push_back(mStep.buffer);
+                }
+            }
+
+            if (schedule.steps.size() != mNumberOfRequiredNodes) {
+                return false; /* cycle */
+            }
+            schedule.buffers.assign(static_cast<size_t>(schedule.number_of_buffers) * _max_block_length, 0.0f);
+            return true;
+        }
+    };
+} // namespace klangwellen
@@ -0,0 +1,185 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * PROCESSOR INTERFACE
+ *
+ * - [x] float process()
+ * - [ ] float process(float)
+ * - [ ] void process(AudioSignal&)
+ * - [x] void process(float*, uint32_t)
+ * - [ ] void process(float*, float*, uint32_t)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace klangwellen {
+    /**
+     * fast pseudo random number generator with per-instance state. the generator runs `NUMBER_OF_LANES` independent
+     * xoshiro128+ generators side by side, their states are stored as structure of arrays so that one step of all lanes
+     * compiles to a few SIMD instructions ( e.g 8 lanes of 32-bit integers with AVX2 ). values are produced one step (
+     * i.e `NUMBER_OF_LANES` values ) at a time and handed out in order by the scalar and the block methods.
+     * <p>
+     * instances do not share any state and can be used from different threads without synchronization. instances
+     * created with the default constructor are seeded differently.
+     */
+    class Random {
+    public:
+        static constexpr uint8_t NUMBER_OF_LANES = 8;
+
+        Random() : Random(next_default_seed()) {}
+
+        explicit Random(const uint32_t seed) {
+            set_seed(seed);
+        }
+
+        void set_seed(const uint32_t seed) {
+            uint32_t mSeed = seed;
+            for (uint8_t l = 0; l < NUMBER_OF_LANES; l++) {
+                _s0[l] = splitmix32(mSeed);
+                _s1[l] = splitmix32(mSeed);
+                _s2[l] = splitmix32(mSeed);
+                _s3[l] = splitmix32(mSeed);
+                if ((_s0[l] | _s1[l] | _s2[l] | _s3[l]) == 0) {
+                    _s0[l] = 1;
+                }
+            }
+            _index = NUMBER_OF_LANES;
+        }
+
+        /**
+         * @return random 32-bit integer
+         */
+        uint32_t next() {
+            if (_index >= NUMBER_OF_LANES) {
+                step();
+                _index = 0;
+            }
+            return _output[_index++];
+        }
+
+        /**
+         * @return random number between 0.0 ... 1.0 ( excluding 1.0 )
+         */
+        float next_normalized() {
+            return to_normalized(next());
+        }
+
+        /**
+         * @return random number between -1.0 ... 1.0 ( excluding 1.0 )
+         */
+        float next_signed() {
+            return to_signed(next());
+        }
+
+        float process() {
+            return next_signed();
+        }
+
+        /**
+         * fills buffer with random numbers between -1.0 ... 1.0
+         */
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            uint32_t i = 0;
+            for (; i < buffer_length && _index < NUMBER_OF_LANES; i++) {
+                signal_buffer[i] = to_signed(_output[_index++]);
+            }
+            for (; i + NUMBER_OF_LANES <= buffer_length; i += NUMBER_OF_LANES) {
+                step();
+                for (uint8_t l = 0; l < NUMBER_OF_LANES; l++) {
+                    signal_buffer[i + l] = to_signed(_output[l]);
+                }
+            }
+            for (; i < buffer_length; i++) {
+                signal_buffer[i] = next_signed();
+            }
+        }
+
+        /**
+         * fills buffer with random numbers between 0.0 ... 1.0
+         */
+        void process_normalized(float* signal_buffer, const uint32_t buffer_length) {
+            uint32_t i = 0;
+            for (; i < buffer_length && _index < NUMBER_OF_LANES; i++) {
+                signal_buffer[i] = to_normalized(_output[_index++]);
+            }
+            for (; i + NUMBER_OF_LANES <= buffer_length; i += NUMBER_OF_LANES) {
+                step();
+                for (uint8_t l = 0; l < NUMBER_OF_LANES; l++) {
+                    signal_buffer[i + l] = to_normalized(_output[l]);
+                }
+            }
+            for (; i < buffer_length; i++) {
+                signal_buffer[i] = next_normalized();
+            }
+        }
+
+        /* the lowest bits of xoshiro128+ are of lower quality, conversions only use the upper 24 bits */
+        static float to_normalized(const uint32_t x) {
+            return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+        }
+
+        static float to_signed(const uint32_t x) {
+            return static_cast<float>(static_cast<int32_t>(x & 0xFFFFFF00)) * (1.0f / 2147483648.0f);
+        }
+
+    private:
+        uint32_t _s0[NUMBER_OF_LANES];
+        uint32_t _s1[NUMBER_OF_LANES];
+        uint32_t _s2[NUMBER_OF_LANES];
+        uint32_t _s3[NUMBER_OF_LANES];
+        uint32_t _output[NUMBER_OF_LANES];
+        uint8_t  _index = NUMBER_OF_LANES;
+
+        inline static std::atomic<uint32_t> _default_seed{23};
+
+        static uint32_t next_default_seed() {
+            return _default_seed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static uint32_t splitmix32(uint32_t& state) {
+            uint32_t z = (state += 0x9E3779B9);
+            z          = (z ^ (z >> 16)) * 0x85EBCA6B;
+            z          = (z ^ (z >> 13)) * 0xC2B2AE35;
+            return z ^ (z >> 16);
+        }
+
+        static uint32_t rotl(const uint32_t x, const int k) {
+            return (x << k) | (x >> (32 - k));
+        }
+
+        /* advances all lanes, written as a plain loop over the lanes so that compilers vectorize it */
+        void step() {
+            for (uint8_t l = 0; l < NUMBER_OF_LANES; l++) {
+                _output[l]       = _s0[l] + _s3[l];
+                const uint32_t t = _s1[l] << 9;
+                _s2[l] ^= _s0[l];
+                _s3[l] ^= _s1[l];
+                _s1[l] ^= _s2[l];
+                _s0[l] ^= _s3[l];
+                _s2[l] ^= t;
+                _s3[l] = rotl(_s3[l], 11);
+            }
+        }
+    };
+} // namespace klangwellen
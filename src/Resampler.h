@@ -0,0 +1,204 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * PROCESSOR INTERFACE
+ *
+ * - [ ] float process()
+ * - [ ] float process(float)
+ * - [ ] void process(AudioSignal&)
+ * - [ ] void process(float*, uint32_t)
+ * - [ ] void process(float*, float*, uint32_t)
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "KlangWellen.h"
+
+namespace klangwellen {
+    /**
+     * band-limited sample rate converter for arbitrary ratios. output samples are computed with a polyphase windowed
+     * sinc filter ( blackman window ), the filter phases are stored in a table and interpolated linearly. when
+     * downsampling the cutoff frequency is lowered to the output nyquist frequency.
+     * <p>
+     * input samples are pulled on demand from a source, which makes it possible to resample signals that are generated
+     * sample by sample:
+     * <pre>
+     * <code>
+     *     Resampler mResampler(22050, 48000);
+     *     float     mOutput = mResampler.process([&]() { return next_input_sample(); });
+     * </code>
+     * </pre>
+     * the resampler delays the signal by `get_latency()` input samples.
+     */
+    class Resampler {
+    public:
+        static constexpr uint8_t  DEFAULT_NUMBER_OF_TAPS   = 16;
+        static constexpr uint16_t DEFAULT_NUMBER_OF_PHASES = 64;
+
+        Resampler(const uint32_t input_sample_rate,
+                  const uint32_t output_sample_rate,
+                  const uint8_t  number_of_taps   = DEFAULT_NUMBER_OF_TAPS,
+                  const uint16_t number_of_phases = DEFAULT_NUMBER_OF_PHASES)
+            : _number_of_taps(std::max<uint8_t>(2, number_of_taps & ~1)),
+              _number_of_phases(std::max<uint16_t>(1, number_of_phases)),
+              _kernel(new float[(_number_of_phases + 1) * _number_of_taps]),
+              _history(new float[_number_of_taps * 2]) {
+            set_sample_rates(input_sample_rate, output_sample_rate);
+        }
+
+        ~Resampler() {
+            delete[] _kernel;
+            delete[] _history;
+        }
+
+        Resampler(const Resampler&)            = delete;
+        Resampler& operator=(const Resampler&) = delete;
+
+        /**
+         * sets input and output sample rate and recomputes the filter kernel. should not be called from the audio
+         * thread.
+         */
+        void set_sample_rates(const uint32_t input_sample_rate, const uint32_t output_sample_rate) {
+            _input_sample_rate  = input_sample_rate;
+            _output_sample_rate = output_sample_rate;
+            _step               = static_cast<float>(input_sample_rate) / output_sample_rate;
+            compute_kernel(std::min(1.0f, 1.0f / _step));
+            reset();
+        }
+
+        uint32_t get_input_sample_rate() const {
+            return _input_sample_rate;
+        }
+
+        uint32_t get_output_sample_rate() const {
+            return _output_sample_rate;
+        }
+
+        /**
+         * @return delay of the output signal in input samples
+         */
+        uint8_t get_latency() const {
+            return _number_of_taps / 2;
+        }
+
+        /**
+         * clears the filter history.
+         */
+        void reset() {
+            std::fill_n(_history, _number_of_taps * 2, 0.0f);
+            _history_index = 0;
+            /* pull the first input sample with the first output sample */
+            _position = 1.0f;
+        }
+
+        /**
+         * computes the next output sample. pulls as many input samples from source as required.
+         *
+         * @param source callable returning the next input sample as `float`
+         */
+        template<typename SOURCE>
+        float process(SOURCE&& source) {
+            while (_position >= 1.0f) {
+                push(source());
+                _position -= 1.0f;
+            }
+            const float   mPhase      = _position * _number_of_phases;
+            const int32_t mPhaseIndex = static_cast<int32_t>(mPhase);
+            const float   mPhaseFrac  = mPhase - mPhaseIndex;
+            const float*  mKernelA    = _kernel + mPhaseIndex * _number_of_taps;
+            const float*  mKernelB    = mKernelA + _number_of_taps;
+            const float*  mHistory    = _history + _history_index;
+            float         a           = 0.0f;
+            float         b           = 0.0f;
+            for (uint8_t i = 0; i < _number_of_taps; i++) {
+                a += mHistory[i] * mKernelA[i];
+                b += mHistory[i] * mKernelB[i];
+            }
+            _position += _step;
+            return a + (b - a) * mPhaseFrac;
+        }
+
+    private:
+        const uint8_t  _number_of_taps;
+        const uint16_t _number_of_phases;
+        float*         _kernel;
+        /* history is stored twice to allow reading `_number_of_taps` consecutive samples without wrapping */
+        float*         _history;
+        uint8_t        _history_index      = 0;
+        float          _position           = 1.0f;
+        float          _step               = 1.0f;
+        uint32_t       _input_sample_rate  = 0;
+        uint32_t       _output_sample_rate = 0;
+
+        void push(const float sample) {
+            _history[_history_index]                   = sample;
+            _history[_history_index + _number_of_taps] = sample;
+            _history_index++;
+            if (_history_index >= _number_of_taps) {
+                _history_index = 0;
+            }
+        }
+
+        /*
+         * phase `p` holds the filter for an output sample located `p / _number_of_phases` input samples after the
+         * center of the history. tap `i` is applied to the `i`-th oldest input sample.
+         */
+        void compute_kernel(const float cutoff) {
+            const int32_t mHalfWidth = _number_of_taps / 2;
+            for (uint16_t p = 0; p <= _number_of_phases; p++) {
+                const float mFraction = static_cast<float>(p) / _number_of_phases;
+                float*      mKernel   = _kernel + p * _number_of_taps;
+                float       mSum      = 0.0f;
+                for (uint8_t i = 0; i < _number_of_taps; i++) {
+                    const float x = static_cast<float>(i - mHalfWidth + 1) - mFraction;
+                    mKernel[i]    = cutoff * sinc(cutoff * x) * blackman(x / mHalfWidth);
+                    mSum += mKernel[i];
+                }
+                /* normalize to unity gain at DC */
+                if (mSum != 0.0f) {
+                    for (uint8_t i = 0; i < _number_of_taps; i++) {
+                        mKernel[i] /= mSum;
+                    }
+                }
+            }
+        }
+
+        static float sinc(const float x) {
+            if (x == 0.0f) {
+                return 1.0f;
+            }
+            return sinf(KW_PI * x) / (KW_PI * x);
+        }
+
+        /* window over [-1, 1] */
+        static float blackman(const float x) {
+            if (x <= -1.0f || x >= 1.0f) {
+                return 0.0f;
+            }
+            const float t = (x + 1.0f) * 0.5f;
+            return 0.42f - 0.5f * cosf(KW_TWO_PI * t) + 0.08f * cosf(2.0f * KW_TWO_PI * t);
+        }
+    };
+} // namespace klangwellen
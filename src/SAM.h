@@ -33,21 +33,27 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
 #include "KlangWellen.h"
+#include "PCMConversion.h"
+#include "Resampler.h"
+#include "SAMPhraseCache.h"
 
 namespace klangwellen {
     class SAM {
     private:
+        // constant tables are shared by all instances, only the render state below is allocated per voice.
+
         // tab40672
-        const uint8_t stressInputTable[9] =
+        static constexpr uint8_t stressInputTable[9] =
             {
                 '*', '1', '2', '3', '4', '5', '6', '7', '8'};
 
         // tab40682
-        const uint8_t signInputTable1[81] = {
+        static constexpr uint8_t signInputTable1[81] = {
             ' ', '.', '?', ',', '-', 'I', 'I', 'E',
             'A', 'A', 'A', 'A', 'U', 'A', 'I', 'E',
             'U', 'O', 'R', 'L', 'W', 'Y', 'W', 'R',
@@ -61,7 +67,7 @@ namespace klangwellen {
             'U'};
 
         // tab40763
-        const uint8_t signInputTable2[81] =
+        static constexpr uint8_t signInputTable2[81] =
             {
                 '*', '*', '*', '*', '*', 'Y', 'H', 'H',
                 'E', 'A', 'H', 'O', 'H', 'X', 'X', 'R',
@@ -76,7 +82,7 @@ namespace klangwellen {
                 'N'};
 
         // loc_9F8C
-        const uint8_t flags[81] = {
+        static constexpr uint8_t flags[81] = {
             0x00, 0x00, 0x00, 0x00, 0x00, 0xA4, 0xA4, 0xA4,
             0xA4, 0xA4, 0xA4, 0x84, 0x84, 0xA4, 0xA4, 0x84,
             0x84, 0x84, 0x84, 0x84, 0x84, 0x84, 0x44, 0x44,
@@ -91,7 +97,7 @@ namespace klangwellen {
 
         //??? flags overlap flags2
         // loc_9FDA
-        const uint8_t flags2[78] = {
+        static constexpr uint8_t flags2[78] = {
             0x80, 0xC1, 0xC1, 0xC1, 0xC1, 0x00, 0x00, 0x00,
             0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
             0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
@@ -104,7 +110,7 @@ namespace klangwellen {
             0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
         // tab45616???
-        const uint8_t phonemeStressedLengthTable[80] =
+        static constexpr uint8_t phonemeStressedLengthTable[80] =
             {
                 0x00, 0x12, 0x12, 0x12, 8, 0xB, 9, 0xB,
                 0xE, 0xF, 0xB, 0x10, 0xC, 6, 6, 0xE,
@@ -118,7 +124,7 @@ namespace klangwellen {
                 7, 2, 4, 7, 1, 4, 5, 5};
 
         // tab45536???
-        const uint8_t phonemeLengthTable[80] =
+        static constexpr uint8_t phonemeLengthTable[80] =
             {
                 0, 0x12, 0x12, 0x12, 8, 8, 8, 8,
                 8, 0xB, 6, 0xC, 0xA, 5, 5, 0xB,
@@ -257,20 +263,20 @@ namespace klangwellen {
 
         // uint8_t input[]={" EYAYOYAWOWUW ULUMUNQ YXWXRXLX/XDX\x9b\0"};
 
-        const uint8_t tab48426[5] = {0x18, 0x1A, 0x17, 0x17, 0x17};
+        static constexpr uint8_t tab48426[5] = {0x18, 0x1A, 0x17, 0x17, 0x17};
 
-        const uint8_t tab47492[11] = {
+        static constexpr uint8_t tab47492[11] = {
             0, 0, 0xE0, 0xE6, 0xEC, 0xF3, 0xF9, 0,
             6, 0xC, 6};
 
-        const uint8_t amplitudeRescale[17] = {
+        static constexpr uint8_t amplitudeRescale[17] = {
             0, 1, 2, 2, 2, 3, 3, 4,
             4, 5, 6, 8, 9, 0xB, 0xD, 0xF, 0 // 17 elements?
         };
 
         // Used to decide which phoneme's blend lengths. The candidate with the lower score is selected.
         // tab45856
-        const uint8_t blendRank[80] = {
+        static constexpr uint8_t blendRank[80] = {
             0, 0x1F, 0x1F, 0x1F, 0x1F, 2, 2, 2,
             2, 2, 2, 2, 2, 2, 5, 5,
             2, 0xA, 2, 8, 5, 5, 0xB, 0xA,
@@ -284,7 +290,7 @@ namespace klangwellen {
 
         // Number of frames at the end of a phoneme devoted to interpolating to next phoneme's final value
         // tab45696
-        const uint8_t outBlendLength[80] =
+        static constexpr uint8_t outBlendLength[80] =
             {
                 0, 2, 2, 2, 2, 4, 4, 4,
                 4, 4, 4, 4, 4, 4, 4, 4,
@@ -299,7 +305,7 @@ namespace klangwellen {
 
         // Number of frames at beginning of a phoneme devoted to interpolating to phoneme's final value
         // tab45776
-        const uint8_t inBlendLength[80] =
+        static constexpr uint8_t inBlendLength[80] =
             {
                 0, 2, 2, 2, 2, 4, 4, 4,
                 4, 4, 4, 4, 4, 4, 4, 4,
@@ -330,7 +336,7 @@ namespace klangwellen {
         // 67: **    27          00011011
         // 70: **    25          00011001
         // tab45936
-        const uint8_t sampledConsonantFlags[80] =
+        static constexpr uint8_t sampledConsonantFlags[80] =
             {
                 0, 0, 0, 0, 0, 0, 0, 0,
                 0, 0, 0, 0, 0, 0, 0, 0,
@@ -343,7 +349,7 @@ namespace klangwellen {
                 0, 0, 0, 0x1B, 0, 0, 0x19, 0,
                 0, 0, 0, 0, 0, 0, 0, 0};
 
-        const uint8_t ampl1data[80] =
+        static constexpr uint8_t ampl1data[80] =
             {
                 0, 0, 0, 0, 0, 0xD, 0xD, 0xE,
                 0xF, 0xF, 0xF, 0xF, 0xF, 0xC, 0xD, 0xC,
@@ -356,7 +362,7 @@ namespace klangwellen {
                 4, 0, 0, 0, 0, 0, 0, 0,
                 0, 0xC, 0, 0, 0, 0, 0xF, 0xF};
 
-        const uint8_t ampl2data[80] =
+        static constexpr uint8_t ampl2data[80] =
             {
                 0, 0, 0, 0, 0, 0xA, 0xB, 0xD,
                 0xE, 0xD, 0xC, 0xC, 0xB, 9, 0xB, 0xB,
@@ -369,7 +375,7 @@ namespace klangwellen {
                 1, 0, 0, 0, 0, 0, 0, 0,
                 0, 0xA, 0, 0, 0xA, 0, 0, 0};
 
-        const uint8_t ampl3data[80] =
+        static constexpr uint8_t ampl3data[80] =
             {
                 0, 0, 0, 0, 0, 8, 7, 8,
                 8, 1, 1, 0, 1, 0, 7, 5,
@@ -383,11 +389,11 @@ namespace klangwellen {
                 0, 7, 0, 0, 5, 0, 0x13, 0x10};
 
         // tab42240
-        const int8_t sinus[256] =
+        static constexpr int8_t sinus[256] =
             {0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46, 49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88, 90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116, 117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127, 127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118, 117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92, 90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51, 49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3, 0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46, -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88, -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116, -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127, -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118, -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92, -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51, -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3};
 
         // tab42496
-        const uint8_t rectangle[256] =
+        static constexpr uint8_t rectangle[256] =
             {
                 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90,
                 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90,
@@ -423,7 +429,7 @@ namespace klangwellen {
                 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70};
 
         // random data ?
-        const uint8_t sampleTable[0x500] =
+        static constexpr uint8_t sampleTable[0x500] =
             {
                 // 00
 
@@ -547,7 +553,7 @@ namespace klangwellen {
                 0xF1, 0x7E, 1, 0xFE, 1, 0xF0, 0xFF, 0, 0x7F, 0xC0, 0x1D, 7, 0xF0, 0xF, 0xC0, 0x7E, 6, 0xE0, 7, 0xE0, 0xF, 0xF8, 6, 0xC1, 0xFE, 1, 0xFC, 3, 0xE0, 0xF, 0, 0xFC};
 
         // some flags
-        const uint8_t tab36376[117] = {
+        static constexpr uint8_t tab36376[117] = {
             0, 0, 0, 0, 0, 0, 0, 0, // 0-7
             0, 0, 0, 0, 0, 0, 0, 0, // 8-15
             0, 0, 0, 0, 0, 0, 0, 0,
@@ -563,7 +569,7 @@ namespace klangwellen {
             32, 32, 155, 32, 192, 185, 32, 205,
             163, 76, 138, 142};
 
-        const uint8_t rules[4076] =
+        static constexpr uint8_t rules[4076] =
             {
                 ']', 'A' | 0x80,
                 ' ', '(', 'A', '.', ')', '=', 'E', 'H', '4', 'Y', '.', ' ' | 0x80,
@@ -1020,7 +1026,7 @@ namespace klangwellen {
                 '(', 'Z', ')', '=', 'Z' | 0x80,
                 'j' | 0x80};
 
-        const uint8_t rules2[447] =
+        static constexpr uint8_t rules2[447] =
             {
                 '(', 'A', ')', '=' | 0x80,
                 '(', '!', ')', '=', '.' | 0x80,
@@ -1067,14 +1073,14 @@ namespace klangwellen {
 
         // 26 items. From 'A' to 'Z'
         //  positions for mem62 and mem63 for each character
-        const uint8_t tab37489[26] =
+        static constexpr uint8_t tab37489[26] =
             {
                 0, 149, 247, 162, 57, 197, 6, 126,
                 199, 38, 55, 78, 145, 241, 85, 161,
                 254, 36, 69, 45, 167, 54, 83, 46,
                 71, 218};
 
-        const uint8_t tab37515[26] =
+        static constexpr uint8_t tab37515[26] =
             {
                 125, 126, 126, 127, 128, 129, 130, 130,
                 130, 132, 132, 132, 132, 132, 133, 135,
@@ -1082,7 +1088,7 @@ namespace klangwellen {
                 140, 140};
 
         /* offset of 21 > 21–127 */
-        const uint8_t SAM_MIDI_NOTE_TOSAM_PITCH_MAP[107] = {
+        static constexpr uint8_t SAM_MIDI_NOTE_TOSAM_PITCH_MAP[107] = {
             0,   // A0
             0,   // A#0
             0,   // B0
@@ -1193,7 +1199,7 @@ namespace klangwellen {
         };
 
         // tab45216
-        const uint8_t freq3data[80] =
+        static constexpr uint8_t freq3data[80] =
             {
                 0x00, 0x5B, 0x5B, 0x5B, 0x5B, 0x6E, 0x5D, 0x5B,
                 0x58, 0x59, 0x57, 0x58, 0x52, 0x59, 0x5D, 0x3E,
@@ -1277,7 +1283,7 @@ namespace klangwellen {
         uint8_t sampledConsonantFlag[256]; // tab44800
 
         // timetable for more accurate c64 simulation
-        int timetable[5][5] = {
+        static constexpr int timetable[5][5] = {
             {162, 167, 167, 127, 128},
             {226, 60, 60, 0, 0},
             {225, 60, 59, 0, 0},
@@ -2248,17 +2254,37 @@ namespace klangwellen {
 
         // void Code47574()
         void Render() {
+            if (RenderFrames()) {
+                while (RenderStep()) {}
+            }
+        }
+
+        // state of the sound output loop, kept between calls to `RenderStep()`
+        struct RenderState {
             uint8_t phase1       = 0; // mem43
             uint8_t phase2       = 0;
             uint8_t phase3       = 0;
             uint8_t mem66        = 0;
             uint8_t mem38        = 0;
+            uint8_t speedcounter = 0; // mem45
+            uint8_t mem48        = 0;
+        };
+
+        RenderState render_state;
+
+        // creates the frames of the phonemes in the output list and prepares the sound output loop. returns false if
+        // there is nothing to render.
+        bool RenderFrames() {
+            uint8_t phase1       = 0; // mem43
+            uint8_t phase2       = 0;
+            uint8_t phase3       = 0;
+            uint8_t mem38        = 0;
             uint8_t mem40        = 0;
             uint8_t speedcounter = 0; // mem45
             uint8_t mem48        = 0;
             int     i;
             if (phonemeIndexOutput[0] == 255)
-                return; // exit if no data
+                return false; // exit if no data
 
             A     = 0;
             X     = 0;
@@ -2658,6 +2684,27 @@ namespace klangwellen {
                 PrintOutput(sampledConsonantFlag, frequency1, frequency2, frequency3, amplitude1, amplitude2, amplitude3, pitches);
             }
 
+            render_state.phase1       = phase1;
+            render_state.phase2       = phase2;
+            render_state.phase3       = phase3;
+            render_state.mem66        = 0;
+            render_state.mem38        = mem38;
+            render_state.speedcounter = speedcounter;
+            render_state.mem48        = mem48;
+            return true;
+        }
+
+        // renders one glottal pulse step ( or one sampled consonant ) of the sound output loop. returns false once all
+        // frames are rendered.
+        bool RenderStep() {
+            uint8_t& phase1       = render_state.phase1;
+            uint8_t& phase2       = render_state.phase2;
+            uint8_t& phase3       = render_state.phase3;
+            uint8_t& mem66        = render_state.mem66;
+            uint8_t& mem38        = render_state.mem38;
+            uint8_t& speedcounter = render_state.speedcounter;
+            uint8_t& mem48        = render_state.mem48;
+
             // PROCESS THE FRAMES
             //
             // In traditional vocal synthesis, the glottal pulse drives filters, which
@@ -2669,7 +2716,7 @@ namespace klangwellen {
 
             // finally the loop for sound output
             // pos48078:
-            while (1) {
+            {
                 // get the sampled information on the phoneme
                 A     = sampledConsonantFlag[Y];
                 mem39 = A;
@@ -2718,7 +2765,7 @@ namespace klangwellen {
 
                 // if the frame count is zero, exit the loop
                 if (mem48 == 0)
-                    return;
+                    return false;
                 speedcounter = speed;
             pos48155:
 
@@ -2739,7 +2786,7 @@ namespace klangwellen {
                     phase1 = 0;
                     phase2 = 0;
                     phase3 = 0;
-                    continue;
+                    return true;
                 }
 
                 // decrement the count
@@ -2751,7 +2798,7 @@ namespace klangwellen {
                     phase1 += frequency1[Y];
                     phase2 += frequency2[Y];
                     phase3 += frequency3[Y];
-                    continue;
+                    return true;
                 }
 
                 // voiced sampled phonemes interleave the sample with the
@@ -2759,60 +2806,9 @@ namespace klangwellen {
                 // the sample for the phoneme.
                 RenderSample(&mem66);
                 goto pos48159;
-            } // while
-
-            // The following code is never reached. It's left over from when
-            // the voiced sample code was part of this loop, instead of part
-            // of RenderSample();
-
-            // pos48315:
-            int tempA;
-            phase1 = A ^ 255;
-            Y      = mem66;
-            do {
-                // pos48321:
-
-                mem56 = 8;
-                A     = Read(mem47, Y);
-
-                // pos48327:
-                do {
-                    // 48327: ASL A
-                    // 48328: BCC 48337
-                    tempA = A;
-                    A     = A << 1;
-                    if ((tempA & 128) != 0) {
-                        X = 26;
-                        // mem[54296] = X;
-                        bufferpos += 150;
-                        const uint32_t pos = bufferpos / 50;
-                        if (pos < SAM_buffer_max_length) {
-                            SAM_buffer[pos] = (X & 15) * 16;
-                        }
-                    } else {
-                        // mem[54296] = 6;
-                        X = 6;
-                        bufferpos += 150;
-                        const uint32_t pos = bufferpos / 50;
-                        if (pos < SAM_buffer_max_length) {
-                            SAM_buffer[pos] = (X & 15) * 16;
-                        }
-                    }
-
-                    for (X = wait2; X > 0; X--); // wait
-                    mem56--;
-                } while (mem56 != 0);
-
-                Y++;
-                phase1++;
-
-            } while (phase1 != 0);
-            //  if (phase1 != 0) goto pos48321;
-            A     = 1;
-            mem44 = 1;
-            mem66 = Y;
-            Y     = mem49;
-            return;
+            }
+            // the unreachable remainder of the original loop ( voiced sample code that was moved to `RenderSample()` )
+            // is omitted.
         }
 
         // Create a rising or falling inflection 30 frames prior to
@@ -2876,23 +2872,23 @@ namespace klangwellen {
             // uint8_t throat; //mem38881
 
             // mouth formants (F1) 5..29
-            const uint8_t mouthFormants5_29[30] = {
+            static constexpr uint8_t mouthFormants5_29[30] = {
                 0, 0, 0, 0, 0, 10,
                 14, 19, 24, 27, 23, 21, 16, 20, 14, 18, 14, 18, 18,
                 16, 13, 15, 11, 18, 14, 11, 9, 6, 6, 6};
 
             // throat formants (F2) 5..29
-            const uint8_t throatFormants5_29[30] = {
+            static constexpr uint8_t throatFormants5_29[30] = {
                 255, 255,
                 255, 255, 255, 84, 73, 67, 63, 40, 44, 31, 37, 45, 73, 49,
                 36, 30, 51, 37, 29, 69, 24, 50, 30, 24, 83, 46, 54, 86};
 
             // there must be no zeros in this 2 tables
             // formant 1 frequencies (mouth) 48..53
-            const uint8_t mouthFormants48_53[6] = {19, 27, 21, 27, 18, 13};
+            static constexpr uint8_t mouthFormants48_53[6] = {19, 27, 21, 27, 18, 13};
 
             // formant 2 frequencies (throat) 48..53
-            const uint8_t throatFormants48_53[6] = {72, 39, 31, 43, 30, 34};
+            static constexpr uint8_t throatFormants48_53[6] = {72, 39, 31, 43, 30, 34};
 
             uint8_t pos = 5; // mem39216
             // pos38942:
@@ -3028,7 +3024,7 @@ namespace klangwellen {
         }
 
         // int Code39771()
-        int SAMMain() {
+        int SAMMain(const bool render = true) {
             Init();
             phonemeindex[255] = 32; // to prevent buffer overflow
 
@@ -3058,15 +3054,41 @@ namespace klangwellen {
                 PrintPhonemes(phonemeindex, phonemeLength, stress);
             }
 
-            PrepareOutput();
+            if (render) {
+                PrepareOutput();
+            } else {
+                BeginOutput();
+            }
 
             return 1;
         }
 
         // void Code48547()
         void PrepareOutput() {
+            BeginOutput();
+            while (PrepareNextOutput()) {
+                Render();
+            }
+        }
+
+        uint8_t prepare_index = 0;
+        bool    prepare_done  = true;
+        bool    frame_active  = false;
+
+        void BeginOutput() {
+            prepare_index = 0;
+            prepare_done  = false;
+            frame_active  = false;
+        }
+
+        // copies the phonemes up to the next sentence break into the output list. returns false once all phonemes are
+        // copied.
+        bool PrepareNextOutput() {
+            if (prepare_done) {
+                return false;
+            }
             A = 0;
-            X = 0;
+            X = prepare_index;
             Y = 0;
 
             // pos48551:
@@ -3075,19 +3097,15 @@ namespace klangwellen {
                 if (A == 255) {
                     A                     = 255;
                     phonemeIndexOutput[Y] = 255;
-                    Render();
-                    return;
+                    prepare_done          = true;
+                    return true;
                 }
                 if (A == 254) {
                     X++;
-                    const int temp = X;
                     // mem[48546] = X;
                     phonemeIndexOutput[Y] = 255;
-                    Render();
-                    // X = mem[48546];
-                    X = temp;
-                    Y = 0;
-                    continue;
+                    prepare_index         = X;
+                    return true;
                 }
 
                 if (A == 0) {
@@ -3103,6 +3121,28 @@ namespace klangwellen {
             }
         }
 
+        // renders the next step of the output. returns false once the output is complete or the buffer is full.
+        bool RenderNext() {
+            if (static_cast<uint32_t>(bufferpos / 50) >= SAM_buffer_max_length) {
+                prepare_done = true;
+                frame_active = false;
+                return false;
+            }
+            if (frame_active) {
+                frame_active = RenderStep();
+                return true;
+            }
+            if (PrepareNextOutput()) {
+                frame_active = RenderFrames();
+                return true;
+            }
+            return false;
+        }
+
+        bool IsRendering() const {
+            return frame_active || !prepare_done;
+        }
+
         // void Code48431()
         void InsertBreath() {
             uint8_t mem54;
@@ -4368,6 +4408,12 @@ namespace klangwellen {
         }
 
     public:
+        /**
+         * sample rate at which SAM renders speech internally
+         */
+        static constexpr uint32_t NATIVE_SAMPLE_RATE  = 22050;
+        static constexpr uint32_t DEFAULT_SAMPLE_RATE = 44100;
+
         SAM() : SAM(65536) {}
 
         explicit SAM(const uint32_t pBufferLength) {
@@ -4385,6 +4431,7 @@ namespace klangwellen {
         }
 
         ~SAM() {
+            release_cached_phrase();
             if (_allocated_buffer) {
                 delete[] SAM_buffer;
             }
@@ -4395,6 +4442,21 @@ namespace klangwellen {
             SAM_buffer_max_length = pBufferLength;
         }
 
+        /**
+         * sets the sample rate of the output signal. speech is rendered at `NATIVE_SAMPLE_RATE` and resampled with a
+         * band-limited filter if the sample rates differ. should not be called from the audio thread.
+         *
+         * @param sample_rate output sample rate in Hz ( default: 44100 )
+         */
+        void set_sample_rate(const uint32_t sample_rate) {
+            _sample_rate = sample_rate;
+            _resampler.set_sample_rates(NATIVE_SAMPLE_RATE, sample_rate);
+        }
+
+        uint32_t get_sample_rate() const {
+            return _sample_rate;
+        }
+
         void set_pitch(const uint8_t pPitch) {
             _pitch = pPitch;
             SetPitch(pPitch); // default: pitch = 64
@@ -4423,7 +4485,60 @@ namespace klangwellen {
             }
         }
 
+        /**
+         * enables streaming mode. in streaming mode `speak()` only translates the text to phonemes, the speech itself
+         * is rendered incrementally in `process()` just ahead of playback. this spreads the cost of rendering over
+         * the audio blocks instead of stalling the calling thread until the whole phrase is rendered.
+         *
+         * @param pStreaming true to render speech while playing ( default: false )
+         */
+        void set_streaming(const bool pStreaming) {
+            _streaming = pStreaming;
+        }
+
+        bool is_streaming() const {
+            return _streaming;
+        }
+
+        /**
+         * @return true if speech is still being rendered in streaming mode
+         */
+        bool is_rendering() const {
+            return IsRendering();
+        }
+
+        /**
+         * sets a cache for rendered phrases. phrases spoken with the same text and voice parameters are rendered once
+         * and then played back from the cache. the cache may be shared by several instances and must outlive them.
+         * <p>
+         * the cache is only modified from `speak()` and `speak_to_buffer()`, never from `process()`. in streaming mode a
+         * phrase is therefore stored in the cache with the next call to `speak()` after it was rendered completely.
+         *
+         * @param pCache phrase cache or nullptr to disable caching ( default )
+         */
+        void set_phrase_cache(SAMPhraseCache* pCache) {
+            release_cached_phrase();
+            _phrase_cache = pCache;
+        }
+
+        SAMPhraseCache* get_phrase_cache() const {
+            return _phrase_cache;
+        }
+
         void speak(std::string pText, const bool pUsePhonemes = false) {
+            store_rendered_phrase();
+            release_cached_phrase();
+            if (_phrase_cache != nullptr) {
+                _phrase_key    = SAMPhraseCache::key(pText, pUsePhonemes, _pitch, _speed, _mouth, _throat, singmode != 0);
+                _cached_phrase = _phrase_cache->acquire(_phrase_key, _cached_phrase_length);
+                if (_cached_phrase != nullptr) {
+                    /* cancel rendering of a previous phrase in streaming mode */
+                    prepare_done = true;
+                    frame_active = false;
+                    speak_from_buffer();
+                    return;
+                }
+            }
             char input[256];
             if (pUsePhonemes) {
                 pText.length() < 255 ? strcpy(input, pText.c_str()) : strncpy(input, pText.c_str(), 255);
@@ -4439,9 +4554,10 @@ namespace klangwellen {
                 // std::cout << "TextToPhonemes: " << input << std::endl;
             }
             SetInput(input);
-            SAMMain();
-            _done_speaking = false;
-            _counter       = 0;
+            SAMMain(!_streaming);
+            _cache_pending = _phrase_cache != nullptr;
+            store_rendered_phrase();
+            speak_from_buffer();
         }
 
         void speak_ascii(const int pASCIIValue) {
@@ -4455,13 +4571,20 @@ namespace klangwellen {
         void speak_from_buffer() {
             _done_speaking = false;
             _counter       = 0;
+            _resampler.reset();
         }
 
         /**
-         * renders text into buffer but does not play it immediately
+         * renders text into buffer but does not play it immediately. a cached phrase is copied into the buffer.
          */
         void speak_to_buffer(std::string pText, const bool pUsePhonemes = false) {
             speak(pText, pUsePhonemes);
+            if (_cached_phrase != nullptr) {
+                copy_cached_phrase_to_buffer();
+            } else {
+                while (RenderNext()) {}
+                store_rendered_phrase();
+            }
             _done_speaking = true;
             _counter       = get_used_buffer_length() - 1;
         }
@@ -4471,25 +4594,47 @@ namespace klangwellen {
             _counter       = get_used_buffer_length() - 1;
         }
 
+        /**
+         * @return number of rendered samples. in streaming mode this grows while speech is played.
+         */
         uint32_t get_used_buffer_length() const {
-            return GetBufferLength() / 50;
+            if (_cached_phrase != nullptr) {
+                return _cached_phrase_length;
+            }
+            return std::min<uint32_t>(GetBufferLength() / 50, SAM_buffer_max_length);
         }
 
         void process(float* signal_buffer, const uint32_t buffer_length) {
-            const uint8_t* mBuffer       = reinterpret_cast<uint8_t*>(GetBuffer());
-            const uint32_t mBufferLength = get_used_buffer_length();
-            for (uint32_t i = 0; i < buffer_length; i += 2) {
-                float mSample = 0.0;
-                if (!_done_speaking && mBufferLength > 0) {
-                    mSample = mBuffer[_counter] / 255.0 * 2.0 - 1.0;
-                    _counter++;
-                    if (_counter >= mBufferLength) {
+            const uint8_t* mBuffer = _cached_phrase != nullptr ? _cached_phrase : reinterpret_cast<uint8_t*>(GetBuffer());
+            if (_done_speaking) {
+                std::fill_n(signal_buffer, buffer_length, 0.0f);
+                return;
+            }
+            if (_sample_rate == NATIVE_SAMPLE_RATE) {
+                for (uint32_t i = 0; i < buffer_length; i++) {
+                    signal_buffer[i] = _done_speaking ? 0.0f : next_sample(mBuffer);
+                }
+                return;
+            }
+            for (uint32_t i = 0; i < buffer_length; i++) {
+                if (_done_speaking) {
+                    signal_buffer[i] = 0.0f;
+                    continue;
+                }
+                signal_buffer[i] = _resampler.process([&]() {
+                    if (render_until(_counter)) {
+                        const float mSample = PCMConversion::to_float(mBuffer[_counter]);
+                        _counter++;
+                        return mSample;
+                    }
+                    /* continue pulling ( silent ) samples until the resampler history is flushed */
+                    if (_counter >= get_used_buffer_length() + _resampler.get_latency()) {
                         _done_speaking = true;
+                        return 0.0f;
                     }
-                    _counter %= mBufferLength;
-                }
-                signal_buffer[i]     = mSample;
-                signal_buffer[i + 1] = mSample;
+                    _counter++;
+                    return 0.0f;
+                });
             }
         }
 
@@ -4508,9 +4653,62 @@ namespace klangwellen {
         uint8_t _mouth;
         uint8_t _speed;
 
-        uint32_t _counter          = 0;
-        bool     _done_speaking    = false;
-        bool     _allocated_buffer = false;
+        uint32_t  _counter          = 0;
+        bool      _done_speaking    = false;
+        bool      _allocated_buffer = false;
+        bool      _streaming        = false;
+        uint32_t  _sample_rate      = DEFAULT_SAMPLE_RATE;
+        Resampler _resampler{NATIVE_SAMPLE_RATE, DEFAULT_SAMPLE_RATE};
+
+        SAMPhraseCache* _phrase_cache         = nullptr;
+        const uint8_t*  _cached_phrase        = nullptr;
+        uint32_t        _cached_phrase_length = 0;
+        std::string     _phrase_key;
+        bool            _cache_pending        = false;
+
+        /* renders speech ( in streaming mode ) until the sample at index is available */
+        bool render_until(const uint32_t index) {
+            while (index >= get_used_buffer_length() && RenderNext()) {}
+            return index < get_used_buffer_length();
+        }
+
+        /* stores the phrase in the buffer in the cache once it is rendered completely */
+        void store_rendered_phrase() {
+            if (_cache_pending && !IsRendering()) {
+                _cache_pending = false;
+                if (_phrase_cache != nullptr) {
+                    _phrase_cache->insert(_phrase_key, reinterpret_cast<uint8_t*>(GetBuffer()), get_used_buffer_length());
+                }
+            }
+        }
+
+        void copy_cached_phrase_to_buffer() {
+            const uint32_t mLength = std::min(_cached_phrase_length, SAM_buffer_max_length);
+            memcpy(SAM_buffer, _cached_phrase, mLength);
+            bufferpos = static_cast<int>(mLength * 50);
+        }
+
+        void release_cached_phrase() {
+            _cache_pending = false;
+            if (_cached_phrase != nullptr) {
+                _phrase_cache->release(_cached_phrase);
+                _cached_phrase        = nullptr;
+                _cached_phrase_length = 0;
+            }
+        }
+
+        float next_sample(const uint8_t* buffer) {
+            if (!render_until(_counter)) {
+                _done_speaking = true;
+                return 0.0f;
+            }
+            const float mSample = PCMConversion::to_float(buffer[_counter]);
+            _counter++;
+            if (!render_until(_counter)) {
+                _done_speaking = true;
+            }
+            return mSample;
+        }
 
         void setDefaults() {
             set_pitch(64);
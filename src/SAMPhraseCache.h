@@ -0,0 +1,296 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+
+#ifndef KLANGWELLEN_SAM_PHRASE_CACHE_MAX_ENTRIES
+#define KLANGWELLEN_SAM_PHRASE_CACHE_MAX_ENTRIES 32
+#endif
+
+namespace klangwellen {
+    /**
+     * least recently used cache for phrases rendered by `SAM`. rendered samples are stored in a memory pool of fixed
+     * size that is allocated once. phrases are identified by a key made of the text and the voice parameters ( see
+     * `key()` ). keys are stored with the phrases and compared on lookup, so phrases with colliding hashes are never
+     * confused. when a new phrase does not fit into the pool the least recently used phrases are evicted. phrases that
+     * are currently played back are pinned and never evicted.
+     * <p>
+     * a cache can be shared by several `SAM` instances but is not thread-safe, i.e all instances must be used from the
+     * same thread. the cache must outlive the instances that use it:
+     * <pre>
+     * <code>
+     *     SAMPhraseCache mCache(131072);
+     *     SAM            mSAM;
+     *     mSAM.set_phrase_cache(&mCache);
+     *     mSAM.speak("hello world"); // rendered and stored
+     *     mSAM.speak("hello world"); // played from cache
+     * </code>
+     * </pre>
+     */
+    class SAMPhraseCache {
+    public:
+        explicit SAMPhraseCache(const uint32_t pool_size = 131072)
+            : _pool(new uint8_t[pool_size]),
+              _pool_size(pool_size) {}
+
+        ~SAMPhraseCache() {
+            delete[] _pool;
+        }
+
+        SAMPhraseCache(const SAMPhraseCache&)            = delete;
+        SAMPhraseCache& operator=(const SAMPhraseCache&) = delete;
+
+        /**
+         * composes the key of a phrase from its text and all parameters that affect rendering.
+         */
+        static std::string key(const std::string& text,
+                               const bool         use_phonemes,
+                               const uint8_t      pitch,
+                               const uint8_t      speed,
+                               const uint8_t      mouth,
+                               const uint8_t      throat,
+                               const bool         sing_mode) {
+            std::string mKey = text;
+            mKey.push_back('\0');
+            mKey.push_back(static_cast<char>(use_phonemes));
+            mKey.push_back(static_cast<char>(pitch));
+            mKey.push_back(static_cast<char>(speed));
+            mKey.push_back(static_cast<char>(mouth));
+            mKey.push_back(static_cast<char>(throat));
+            mKey.push_back(static_cast<char>(sing_mode));
+            return mKey;
+        }
+
+        /**
+         * looks up a phrase and pins it. a pinned phrase is not evicted until it is released with `release()`.
+         *
+         * @param key    key of the phrase
+         * @param length receives the number of samples of the phrase
+         * @return samples of the phrase or nullptr if the phrase is not cached
+         */
+        const uint8_t* acquire(const std::string& key, uint32_t& length) {
+            Entry* mEntry = find(key);
+            if (mEntry == nullptr) {
+                return nullptr;
+            }
+            mEntry->pins++;
+            mEntry->last_used = ++_clock;
+            length            = mEntry->length;
+            return get_data(*mEntry);
+        }
+
+        /**
+         * unpins a phrase previously returned by `acquire()`.
+         */
+        void release(const uint8_t* data) {
+            for (Entry& mEntry : _entries) {
+                if (mEntry.used && get_data(mEntry) == data && mEntry.pins > 0) {
+                    mEntry.pins--;
+                    return;
+                }
+            }
+        }
+
+        /**
+         * stores a rendered phrase together with its key. least recently used phrases are evicted to make room.
+         *
+         * @return true if the phrase was stored, false if it is larger than the pool or the pool is occupied by pinned
+         * phrases
+         */
+        bool insert(const std::string& key, const uint8_t* data, const uint32_t length) {
+            if (length == 0 || key.size() > _pool_size || length > _pool_size - key.size()) {
+                return false;
+            }
+            Entry* mEntry = find(key);
+            if (mEntry != nullptr) {
+                mEntry->last_used = ++_clock;
+                return true;
+            }
+            const uint32_t mSize = static_cast<uint32_t>(key.size()) + length;
+            uint32_t       mOffset;
+            while (!find_free_space(mSize, mOffset)) {
+                if (!evict_least_recently_used()) {
+                    return false;
+                }
+            }
+            mEntry = find_free_entry();
+            if (mEntry == nullptr) {
+                if (!evict_least_recently_used()) {
+                    return false;
+                }
+                mEntry = find_free_entry();
+            }
+            memcpy(_pool + mOffset, key.data(), key.size());
+            memcpy(_pool + mOffset + key.size(), data, length);
+            mEntry->used       = true;
+            mEntry->hash       = hash(key);
+            mEntry->offset     = mOffset;
+            mEntry->key_length = static_cast<uint32_t>(key.size());
+            mEntry->length     = length;
+            mEntry->pins       = 0;
+            mEntry->last_used  = ++_clock;
+            return true;
+        }
+
+        bool contains(const std::string& key) {
+            return find(key) != nullptr;
+        }
+
+        /**
+         * removes all phrases that are not pinned.
+         */
+        void clear() {
+            for (Entry& mEntry : _entries) {
+                if (mEntry.pins == 0) {
+                    mEntry.used = false;
+                }
+            }
+        }
+
+        uint8_t get_number_of_phrases() const {
+            uint8_t mCount = 0;
+            for (const Entry& mEntry : _entries) {
+                mCount += mEntry.used;
+            }
+            return mCount;
+        }
+
+        uint32_t get_used_size() const {
+            uint32_t mSize = 0;
+            for (const Entry& mEntry : _entries) {
+                if (mEntry.used) {
+                    mSize += get_size(mEntry);
+                }
+            }
+            return mSize;
+        }
+
+        uint32_t get_pool_size() const {
+            return _pool_size;
+        }
+
+    private:
+        static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+        static constexpr uint64_t FNV_PRIME        = 1099511628211ULL;
+
+        /* the key is stored at the offset in the pool, followed by the samples */
+        struct Entry {
+            uint64_t hash       = 0;
+            uint32_t offset     = 0;
+            uint32_t key_length = 0;
+            uint32_t length     = 0;
+            uint32_t last_used  = 0;
+            uint16_t pins       = 0;
+            bool     used       = false;
+        };
+
+        uint8_t*       _pool;
+        const uint32_t _pool_size;
+        Entry          _entries[KLANGWELLEN_SAM_PHRASE_CACHE_MAX_ENTRIES];
+        uint32_t       _clock = 0;
+
+        /* 64-bit FNV-1a */
+        static uint64_t hash(const std::string& key) {
+            uint64_t mHash = FNV_OFFSET_BASIS;
+            for (const char c : key) {
+                mHash = (mHash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+            }
+            return mHash;
+        }
+
+        const uint8_t* get_data(const Entry& entry) const {
+            return _pool + entry.offset + entry.key_length;
+        }
+
+        static uint32_t get_size(const Entry& entry) {
+            return entry.key_length + entry.length;
+        }
+
+        Entry* find(const std::string& key) {
+            const uint64_t mHash = hash(key);
+            for (Entry& mEntry : _entries) {
+                if (mEntry.used && mEntry.hash == mHash && mEntry.key_length == key.size() &&
+                    memcmp(_pool + mEntry.offset, key.data(), key.size()) == 0) {
+                    return &mEntry;
+                }
+            }
+            return nullptr;
+        }
+
+        Entry* find_free_entry() {
+            for (Entry& mEntry : _entries) {
+                if (!mEntry.used) {
+                    return &mEntry;
+                }
+            }
+            return nullptr;
+        }
+
+        /* first fit: candidates are the start of the pool and the end of every stored phrase */
+        bool find_free_space(const uint32_t length, uint32_t& offset) const {
+            bool mFound = false;
+            if (fits(0, length)) {
+                offset = 0;
+                mFound = true;
+            }
+            for (const Entry& mEntry : _entries) {
+                if (!mEntry.used) {
+                    continue;
+                }
+                const uint32_t mCandidate = mEntry.offset + get_size(mEntry);
+                if ((!mFound || mCandidate < offset) && fits(mCandidate, length)) {
+                    offset = mCandidate;
+                    mFound = true;
+                }
+            }
+            return mFound;
+        }
+
+        bool fits(const uint32_t offset, const uint32_t length) const {
+            if (length > _pool_size - offset) {
+                return false;
+            }
+            for (const Entry& mEntry : _entries) {
+                if (mEntry.used && offset < mEntry.offset + get_size(mEntry) && mEntry.offset < offset + length) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool evict_least_recently_used() {
+            Entry* mOldest = nullptr;
+            for (Entry& mEntry : _entries) {
+                if (mEntry.used && mEntry.pins == 0 && (mOldest == nullptr || mEntry.last_used < mOldest->last_used)) {
+                    mOldest = &mEntry;
+                }
+            }
+            if (mOldest == nullptr) {
+                return false;
+            }
+            mOldest->used = false;
+            return true;
+        }
+    };
+} // namespace klangwellen
@@ -0,0 +1,136 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace klangwellen {
+    /**
+     * wait-free single-producer single-consumer ring buffer. exactly one thread may write ( `write`, `push` ) and
+     * exactly one other thread may read ( `read`, `pop`, `discard` ) at the same time. neither side ever blocks or
+     * allocates memory, which makes it suitable to pass data to and from the audio thread.
+     * <p>
+     * the capacity is rounded up to the next power of two.
+     */
+    template<typename T>
+    class SPSCRingBuffer {
+    public:
+        explicit SPSCRingBuffer(const uint32_t capacity) : _capacity(next_power_of_two(capacity)),
+                                                           _mask(_capacity - 1),
+                                                           _buffer(new T[_capacity]) {}
+
+        ~SPSCRingBuffer() {
+            delete[] _buffer;
+        }
+
+        SPSCRingBuffer(const SPSCRingBuffer&)            = delete;
+        SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+        uint32_t get_capacity() const {
+            return _capacity;
+        }
+
+        /**
+         * @return number of elements that can be read. may only be called from the consumer thread.
+         */
+        uint32_t available_to_read() const {
+            return _write_index.load(std::memory_order_acquire) - _read_index.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @return number of elements that can be written. may only be called from the producer thread.
+         */
+        uint32_t available_to_write() const {
+            return _capacity - (_write_index.load(std::memory_order_relaxed) - _read_index.load(std::memory_order_acquire));
+        }
+
+        /**
+         * writes up to `length` elements. may only be called from the producer thread.
+         *
+         * @return number of elements actually written
+         */
+        uint32_t write(const T* data, const uint32_t length) {
+            const uint32_t mWriteIndex = _write_index.load(std::memory_order_relaxed);
+            const uint32_t mFree       = _capacity - (mWriteIndex - _read_index.load(std::memory_order_acquire));
+            const uint32_t mLength     = length < mFree ? length : mFree;
+            for (uint32_t i = 0; i < mLength; i++) {
+                _buffer[(mWriteIndex + i) & _mask] = data[i];
+            }
+            _write_index.store(mWriteIndex + mLength, std::memory_order_release);
+            return mLength;
+        }
+
+        /**
+         * reads up to `length` elements. may only be called from the consumer thread.
+         *
+         * @return number of elements actually read
+         */
+        uint32_t read(T* data, const uint32_t length) {
+            const uint32_t mReadIndex = _read_index.load(std::memory_order_relaxed);
+            const uint32_t mUsed      = _write_index.load(std::memory_order_acquire) - mReadIndex;
+            const uint32_t mLength    = length < mUsed ? length : mUsed;
+            for (uint32_t i = 0; i < mLength; i++) {
+                data[i] = _buffer[(mReadIndex + i) & _mask];
+            }
+            _read_index.store(mReadIndex + mLength, std::memory_order_release);
+            return mLength;
+        }
+
+        bool push(const T& element) {
+            return write(&element, 1) == 1;
+        }
+
+        bool pop(T& element) {
+            return read(&element, 1) == 1;
+        }
+
+        /**
+         * drops up to `length` elements without reading them. may only be called from the consumer thread.
+         *
+         * @return number of elements actually dropped
+         */
+        uint32_t discard(const uint32_t length) {
+            const uint32_t mReadIndex = _read_index.load(std::memory_order_relaxed);
+            const uint32_t mUsed      = _write_index.load(std::memory_order_acquire) - mReadIndex;
+            const uint32_t mLength    = length < mUsed ? length : mUsed;
+            _read_index.store(mReadIndex + mLength, std::memory_order_release);
+            return mLength;
+        }
+
+    private:
+        const uint32_t _capacity;
+        const uint32_t _mask;
+        T*             _buffer;
+        /* indices only ever increase and are wrapped with `_mask` on access. they live on separate cache lines to avoid
+         * false sharing between producer and consumer. */
+        alignas(64) std::atomic<uint32_t> _write_index{0};
+        alignas(64) std::atomic<uint32_t> _read_index{0};
+
+        static uint32_t next_power_of_two(uint32_t value) {
+            uint32_t mPowerOfTwo = 1;
+            while (mPowerOfTwo < value) {
+                mPowerOfTwo <<= 1;
+            }
+            return mPowerOfTwo;
+        }
+    };
+} // namespace klangwellen
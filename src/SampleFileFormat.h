@@ -0,0 +1,253 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "KlangWellen.h"
+
+namespace klangwellen {
+    /**
+     * parses the header of a WAV or AIFF file and describes the location and format of its sample data.
+     */
+    class SampleFileFormat {
+    public:
+        static constexpr uint8_t FORMAT_UNDEFINED = 0xFF;
+        static constexpr uint8_t FORMAT_FLOAT32   = 0xFE;
+
+        /**
+         * parses a file header. the header must at least contain all chunks up to the beginning of the sample data.
+         *
+         * @param header        pointer to the beginning of the file
+         * @param header_length number of bytes available at `header`
+         * @param file_length   total length of the file in bytes ( used to clamp the sample data length )
+         * @return true if the header describes a supported sample format
+         */
+        bool parse(const uint8_t* header, const size_t header_length, const size_t file_length) {
+            clear();
+            if (header == nullptr || header_length < 12) {
+                return false;
+            }
+            if (memcmp(header, "RIFF", 4) == 0 && memcmp(header + 8, "WAVE", 4) == 0) {
+                return parse_WAV(header, header_length, file_length);
+            }
+            if (memcmp(header, "FORM", 4) == 0 &&
+                (memcmp(header + 8, "AIFF", 4) == 0 || memcmp(header + 8, "AIFC", 4) == 0)) {
+                return parse_AIFF(header, header_length, file_length, memcmp(header + 8, "AIFC", 4) == 0);
+            }
+            return false;
+        }
+
+        void clear() {
+            _data_offset        = 0;
+            _data_length        = 0;
+            _format             = FORMAT_UNDEFINED;
+            _sample_rate        = 0;
+            _number_of_channels = 0;
+            _bits_per_sample    = 0;
+            _number_of_frames   = 0;
+        }
+
+        /**
+         * @return offset of sample data from the beginning of the file in bytes
+         */
+        size_t get_data_offset() const {
+            return _data_offset;
+        }
+
+        /**
+         * @return length of sample data in bytes
+         */
+        uint32_t get_data_length() const {
+            return _data_length;
+        }
+
+        /**
+         * @return sample format as one of the `KlangWellen::SIG_*` constants, `FORMAT_FLOAT32` or `FORMAT_UNDEFINED`
+         */
+        uint8_t get_format() const {
+            return _format;
+        }
+
+        uint32_t get_sample_rate() const {
+            return _sample_rate;
+        }
+
+        uint16_t get_number_of_channels() const {
+            return _number_of_channels;
+        }
+
+        uint16_t get_bits_per_sample() const {
+            return _bits_per_sample;
+        }
+
+        uint16_t get_bytes_per_sample() const {
+            return (_bits_per_sample + 7) / 8;
+        }
+
+        uint32_t get_number_of_frames() const {
+            return _number_of_frames;
+        }
+
+    private:
+        static constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+        size_t   _data_offset        = 0;
+        uint32_t _data_length        = 0;
+        uint8_t  _format             = FORMAT_UNDEFINED;
+        uint32_t _sample_rate        = 0;
+        uint16_t _number_of_channels = 0;
+        uint16_t _bits_per_sample    = 0;
+        uint32_t _number_of_frames   = 0;
+
+        static uint32_t read_u32_le(const uint8_t* p) {
+            return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        static uint16_t read_u16_le(const uint8_t* p) {
+            return p[0] | (p[1] << 8);
+        }
+
+        static uint32_t read_u32_be(const uint8_t* p) {
+            return (static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+        }
+
+        static uint16_t read_u16_be(const uint8_t* p) {
+            return (p[0] << 8) | p[1];
+        }
+
+        /* 80-bit IEEE 754 extended precision ( as used for the sample rate in AIFF files ) */
+        static uint32_t read_extended_be(const uint8_t* p) {
+            const int32_t  mExponent = ((p[0] & 0x7F) << 8 | p[1]) - 16383;
+            const uint32_t mMantissa = read_u32_be(p + 2);
+            if (mExponent < 0 || mExponent > 31) {
+                return 0;
+            }
+            return mMantissa >> (31 - mExponent);
+        }
+
+        void set_data(const size_t data_offset, const size_t data_length, const size_t file_length) {
+            const size_t mAvailable = data_offset < file_length ? file_length - data_offset : 0;
+            _data_offset            = data_offset;
+            _data_length            = static_cast<uint32_t>(data_length < mAvailable ? data_length : mAvailable);
+        }
+
+        bool parse_WAV(const uint8_t* header, const size_t header_length, const size_t file_length) {
+            uint16_t mFormatTag = 0;
+            bool     mHasFormat = false;
+            bool     mHasData   = false;
+            size_t   mPosition  = 12;
+            while (mPosition + 8 <= header_length) {
+                const uint8_t* mChunk       = header + mPosition;
+                const uint32_t mChunkLength = read_u32_le(mChunk + 4);
+                const size_t   mChunkData   = mPosition + 8;
+                if (memcmp(mChunk, "fmt ", 4) == 0 && mChunkLength >= 16 && mChunkData + 16 <= header_length) {
+                    mFormatTag          = read_u16_le(header + mChunkData);
+                    _number_of_channels = read_u16_le(header + mChunkData + 2);
+                    _sample_rate        = read_u32_le(header + mChunkData + 4);
+                    _bits_per_sample    = read_u16_le(header + mChunkData + 14);
+                    if (mFormatTag == WAVE_FORMAT_EXTENSIBLE && mChunkLength >= 26 && mChunkData + 26 <= header_length) {
+                        /* first two bytes of sub format GUID hold the actual format tag */
+                        mFormatTag = read_u16_le(header + mChunkData + 24);
+                    }
+                    mHasFormat = true;
+                } else if (memcmp(mChunk, "data", 4) == 0 && mHasFormat) {
+                    set_data(mChunkData, mChunkLength, file_length);
+                    mHasData = true;
+                    break;
+                }
+                /* chunks are word aligned */
+                mPosition = mChunkData + mChunkLength + (mChunkLength & 1);
+            }
+            if (!mHasData || _number_of_channels == 0 || _bits_per_sample == 0) {
+                return false;
+            }
+            if (mFormatTag == KlangWellen::WAV_FORMAT_IEEE_FLOAT_32BIT && _bits_per_sample == 32) {
+                _format = FORMAT_FLOAT32;
+            } else if (mFormatTag == KlangWellen::WAV_FORMAT_PCM) {
+                _format = format_from_bits(_bits_per_sample, true, false);
+            }
+            compute_number_of_frames();
+            return _format != FORMAT_UNDEFINED;
+        }
+
+        bool parse_AIFF(const uint8_t* header, const size_t header_length, const size_t file_length, const bool is_AIFC) {
+            bool   mLittleEndian = false;
+            bool   mHasCommon    = false;
+            bool   mHasData      = false;
+            size_t mPosition     = 12;
+            while (mPosition + 8 <= header_length && !(mHasCommon && mHasData)) {
+                const uint8_t* mChunk       = header + mPosition;
+                const uint32_t mChunkLength = read_u32_be(mChunk + 4);
+                const size_t   mChunkData   = mPosition + 8;
+                if (memcmp(mChunk, "COMM", 4) == 0 && mChunkLength >= 18 && mChunkData + 18 <= header_length) {
+                    _number_of_channels = read_u16_be(header + mChunkData);
+                    _bits_per_sample    = read_u16_be(header + mChunkData + 6);
+                    _sample_rate        = read_extended_be(header + mChunkData + 8);
+                    if (is_AIFC && mChunkLength >= 22 && mChunkData + 22 <= header_length) {
+                        const uint8_t* mCompression = header + mChunkData + 18;
+                        if (memcmp(mCompression, "sowt", 4) == 0) {
+                            mLittleEndian = true;
+                        } else if (memcmp(mCompression, "NONE", 4) != 0 && memcmp(mCompression, "twos", 4) != 0) {
+                            return false;
+                        }
+                    }
+                    mHasCommon = true;
+                } else if (memcmp(mChunk, "SSND", 4) == 0 && mChunkLength >= 8 && mChunkData + 8 <= header_length) {
+                    const uint32_t mOffset = read_u32_be(header + mChunkData);
+                    if (mOffset > mChunkLength - 8) {
+                        return false;
+                    }
+                    set_data(mChunkData + 8 + mOffset, mChunkLength - 8 - mOffset, file_length);
+                    mHasData = true;
+                }
+                mPosition = mChunkData + mChunkLength + (mChunkLength & 1);
+            }
+            if (!mHasData || !mHasCommon || _number_of_channels == 0 || _bits_per_sample == 0) {
+                return false;
+            }
+            _format = format_from_bits(_bits_per_sample, mLittleEndian, true);
+            compute_number_of_frames();
+            return _format != FORMAT_UNDEFINED;
+        }
+
+        static uint8_t format_from_bits(const uint16_t bits_per_sample, const bool little_endian, const bool signed_8bit) {
+            switch (bits_per_sample) {
+                case 8:
+                    return signed_8bit ? KlangWellen::SIG_INT8 : KlangWellen::SIG_UINT8;
+                case 16:
+                    return little_endian ? KlangWellen::SIG_INT16_LITTLE_ENDIAN : KlangWellen::SIG_INT16_BIG_ENDIAN;
+                case 24:
+                    return little_endian ? KlangWellen::SIG_INT24_3_LITTLE_ENDIAN : KlangWellen::SIG_INT24_3_BIG_ENDIAN;
+                case 32:
+                    return little_endian ? KlangWellen::SIG_INT32_LITTLE_ENDIAN : KlangWellen::SIG_INT32_BIG_ENDIAN;
+                default:
+                    return FORMAT_UNDEFINED;
+            }
+        }
+
+        void compute_number_of_frames() {
+            const uint32_t mBytesPerFrame = _number_of_channels * get_bytes_per_sample();
+            _number_of_frames             = mBytesPerFrame > 0 ? _data_length / mBytesPerFrame : 0;
+        }
+    };
+} // namespace klangwellen
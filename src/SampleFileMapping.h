@@ -0,0 +1,310 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <type_traits>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX /* `min` and `max` macros break `std::min` and `std::max` */
+#endif
+#include <windows.h>
+#define KLANGWELLEN_SAMPLE_FILE_MAPPING_AVAILABLE 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define KLANGWELLEN_SAMPLE_FILE_MAPPING_AVAILABLE 1
+#else
+#define KLANGWELLEN_SAMPLE_FILE_MAPPING_AVAILABLE 0
+#endif
+
+#include "KlangWellen.h"
+#include "SampleFileFormat.h"
+#include "Sampler.h"
+
+namespace klangwellen {
+    /**
+     * maps a WAV or AIFF file into memory and exposes its PCM data directly as a sample buffer without copying or
+     * converting it. pages are loaded on demand by the operating system and shared between processes mapping the same
+     * file. the mapping is private ( i.e copy-on-write ), so writing to the buffer ( e.g when recording into a sampler )
+     * does not modify the file.
+     * <p>
+     * the following sample formats can be used without conversion:
+     * <ul>
+     * <li>WAV 8-bit PCM as `uint8_t` ( `SamplerUI8` )
+     * <li>WAV 16-bit PCM as `int16_t` ( `SamplerI16` )
+     * <li>WAV 32-bit IEEE float as `float` ( `SamplerF32` )
+     * <li>AIFF 8-bit PCM as `int8_t` ( `SamplerI8` )
+     * <li>AIFF-C 16-bit little endian PCM ( compression type `sowt` ) as `int16_t` ( `SamplerI16` )
+     * </ul>
+     * other formats ( e.g big endian 16-bit AIFF or 24-bit PCM ) are parsed and reported via `get_format()` but can not
+     * be accessed as a typed sample buffer. memory mapping is only available on desktop platforms ( POSIX and Windows ).
+     * <p>
+     * a typical application could look as follows:
+     * <pre>
+     * <code>
+     *     SampleFileMapping mFile;
+     *     SamplerI16        mSampler(48000);
+     *     if (mFile.open("piano.wav")) {
+     *         mFile.attach(mSampler);
+     *     }
+     * </code>
+     * </pre>
+     * note that the mapping must stay open as long as the sampler uses the buffer.
+     */
+    class SampleFileMapping {
+    public:
+        static constexpr uint8_t FORMAT_UNDEFINED = SampleFileFormat::FORMAT_UNDEFINED;
+        static constexpr uint8_t FORMAT_FLOAT32   = SampleFileFormat::FORMAT_FLOAT32;
+
+        SampleFileMapping() = default;
+
+        explicit SampleFileMapping(const char* filepath) {
+            open(filepath);
+        }
+
+        ~SampleFileMapping() {
+            close();
+        }
+
+        SampleFileMapping(const SampleFileMapping&)            = delete;
+        SampleFileMapping& operator=(const SampleFileMapping&) = delete;
+
+        /**
+         * maps a file into memory and parses its header.
+         *
+         * @param filepath path to a WAV or AIFF file
+         * @return true if the file was mapped and contains a readable sample format
+         */
+        bool open(const char* filepath) {
+            close();
+            if (!map_file(filepath)) {
+                return false;
+            }
+            if (!parse_header()) {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        void close() {
+            unmap_file();
+            _data = nullptr;
+            _file_format.clear();
+        }
+
+        bool is_open() const {
+            return _data != nullptr;
+        }
+
+        uint32_t get_sample_rate() const {
+            return _file_format.get_sample_rate();
+        }
+
+        uint16_t get_number_of_channels() const {
+            return _file_format.get_number_of_channels();
+        }
+
+        uint16_t get_bits_per_sample() const {
+            return _file_format.get_bits_per_sample();
+        }
+
+        uint32_t get_number_of_frames() const {
+            return _file_format.get_number_of_frames();
+        }
+
+        /**
+         * @return sample format as one of the `KlangWellen::SIG_*` constants, `FORMAT_FLOAT32` or `FORMAT_UNDEFINED`
+         */
+        uint8_t get_format() const {
+            return _file_format.get_format();
+        }
+
+        /**
+         * @return pointer to raw ( interleaved ) sample data as stored in the file
+         */
+        uint8_t* get_data() const {
+            return _data;
+        }
+
+        /**
+         * @return length of raw sample data in bytes
+         */
+        uint32_t get_data_length() const {
+            return _file_format.get_data_length();
+        }
+
+        /**
+         * returns the sample data as a typed buffer if the sample format of the file matches the requested type. the
+         * buffer contains `get_number_of_frames() * get_number_of_channels()` interleaved samples.
+         *
+         * @return typed pointer to sample data or `nullptr` if the file format does not match the requested type
+         */
+        template<typename T>
+        T* get_samples() const {
+            if (_data == nullptr || !is_format_of<T>(_file_format.get_format())) {
+                return nullptr;
+            }
+            if (reinterpret_cast<uintptr_t>(_data) % alignof(T) != 0) {
+                return nullptr;
+            }
+            return reinterpret_cast<T*>(_data);
+        }
+
+        /**
+         * sets the mapped sample data as buffer of a sampler. the sampler does not take ownership of the buffer.
+         *
+         * @return true if the file is a mono file and its sample format matches the sampler’s buffer type
+         */
+        template<typename T>
+        bool attach(SamplerT<T>& sampler) const {
+            T* mSamples = get_samples<T>();
+            if (mSamples == nullptr || _file_format.get_number_of_channels() != 1) {
+                return false;
+            }
+            sampler.set_buffer(mSamples, static_cast<int32_t>(_file_format.get_number_of_frames()));
+            return true;
+        }
+
+    private:
+        uint8_t*         _file_data   = nullptr;
+        size_t           _file_length = 0;
+        uint8_t*         _data        = nullptr;
+        SampleFileFormat _file_format;
+
+        template<typename T>
+        static bool is_format_of(const uint8_t format) {
+            if (std::is_same<T, float>::value) {
+                return format == FORMAT_FLOAT32;
+            }
+            if (std::is_same<T, int16_t>::value) {
+                return format == (KlangWellen::is_host_little_endian() ? KlangWellen::SIG_INT16_LITTLE_ENDIAN : KlangWellen::SIG_INT16_BIG_ENDIAN);
+            }
+            if (std::is_same<T, int8_t>::value) {
+                return format == KlangWellen::SIG_INT8;
+            }
+            if (std::is_same<T, uint8_t>::value) {
+                return format == KlangWellen::SIG_UINT8;
+            }
+            return false;
+        }
+
+        bool parse_header() {
+            if (!_file_format.parse(_file_data, _file_length, _file_length)) {
+                return false;
+            }
+            _data = _file_data + _file_format.get_data_offset();
+            return true;
+        }
+
+#if defined(_WIN32)
+        HANDLE _file_handle    = INVALID_HANDLE_VALUE;
+        HANDLE _mapping_handle = nullptr;
+
+        bool map_file(const char* filepath) {
+            _file_handle = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (_file_handle == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+            LARGE_INTEGER mFileSize;
+            if (!GetFileSizeEx(_file_handle, &mFileSize) || mFileSize.QuadPart == 0) {
+                unmap_file();
+                return false;
+            }
+            _mapping_handle = CreateFileMappingA(_file_handle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            if (_mapping_handle == nullptr) {
+                unmap_file();
+                return false;
+            }
+            _file_data = static_cast<uint8_t*>(MapViewOfFile(_mapping_handle, FILE_MAP_COPY, 0, 0, 0));
+            if (_file_data == nullptr) {
+                unmap_file();
+                return false;
+            }
+            _file_length = static_cast<size_t>(mFileSize.QuadPart);
+            return true;
+        }
+
+        void unmap_file() {
+            if (_file_data != nullptr) {
+                UnmapViewOfFile(_file_data);
+            }
+            if (_mapping_handle != nullptr) {
+                CloseHandle(_mapping_handle);
+            }
+            if (_file_handle != INVALID_HANDLE_VALUE) {
+                CloseHandle(_file_handle);
+            }
+            _file_data      = nullptr;
+            _file_length    = 0;
+            _mapping_handle = nullptr;
+            _file_handle    = INVALID_HANDLE_VALUE;
+        }
+#elif KLANGWELLEN_SAMPLE_FILE_MAPPING_AVAILABLE
+        bool map_file(const char* filepath) {
+            const int mFileDescriptor = ::open(filepath, O_RDONLY);
+            if (mFileDescriptor < 0) {
+                return false;
+            }
+            struct stat mFileStat;
+            if (fstat(mFileDescriptor, &mFileStat) != 0 || mFileStat.st_size <= 0) {
+                ::close(mFileDescriptor);
+                return false;
+            }
+            void* mMapping = mmap(nullptr, static_cast<size_t>(mFileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, mFileDescriptor, 0);
+            /* the mapping stays valid after the file descriptor is closed */
+            ::close(mFileDescriptor);
+            if (mMapping == MAP_FAILED) {
+                return false;
+            }
+            _file_data   = static_cast<uint8_t*>(mMapping);
+            _file_length = static_cast<size_t>(mFileStat.st_size);
+            return true;
+        }
+
+        void unmap_file() {
+            if (_file_data != nullptr) {
+                munmap(_file_data, _file_length);
+            }
+            _file_data   = nullptr;
+            _file_length = 0;
+        }
+#else
+        bool map_file(const char* filepath) {
+            (void) filepath;
+            return false;
+        }
+
+        void unmap_file() {
+            _file_data   = nullptr;
+            _file_length = 0;
+        }
+#endif
+    };
+} // namespace klangwellen
@@ -29,16 +29,19 @@
 
 /*
  * TODO
- * - LINE 325: check for memory leak and change recording mechanism in a way that the maximum length can be specified beforehand as well as a pre-allocated buffer
  * - LINE 153: "huuui, this is not nice and might cause some trouble somewhere"
  * - LINE 220: "evaluate direction?"
  */
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 #include "KlangWellen.h"
+#include "PCMConversion.h"
+#include "ScheduledEvent.h"
 
 namespace klangwellen {
     class SamplerListener {
@@ -64,14 +67,18 @@ namespace klangwellen {
         SamplerT(BUFFER_TYPE*   buffer,
                  const int32_t  buffer_length,
                  const uint32_t sample_rate) : _sample_rate(sample_rate),
+                                               _buffer(nullptr),
+                                               _buffer_length(0),
                                                _direction_forward(true),
                                                _in_point(0),
                                                _out_point(0),
-                                               _speed(0) {
+                                               _speed(0),
+                                               _allocated_buffer(false) {
             set_buffer(buffer, buffer_length);
             _buffer_index       = 0;
             _interpolate_samples = false;
             _edge_fade_padding    = 0;
+            _evaluate_loop       = false;
             _is_playing          = false;
             set_in(0);
             set_out(_buffer_length - 1);
@@ -83,9 +90,11 @@ namespace klangwellen {
         }
 
         ~SamplerT() {
+            free_recording_buffers();
             if (_allocated_buffer) {
                 delete[] _buffer;
             }
+            delete[] _loop_splice;
         }
 
         void add_listener(SamplerListener* sampler_listener) {
@@ -156,6 +165,14 @@ namespace klangwellen {
             return _buffer_length;
         }
 
+        /**
+         * @return index of the first sample in the buffer returned by `get_buffer()`. playback starts at this offset and
+         * wraps around the end of the buffer ( e.g after `end_recording()` swapped a wrapped recording into playback ).
+         */
+        int32_t get_buffer_offset() const {
+            return _buffer_offset;
+        }
+
         void set_buffer(BUFFER_TYPE* buffer, const int32_t buffer_length) {
             if (_buffer != nullptr && _allocated_buffer) {
                 delete[] _buffer;
@@ -163,12 +180,14 @@ namespace klangwellen {
             _allocated_buffer = false; // TODO huuui, this is not nice and might cause some trouble somewhere
             _buffer           = buffer;
             _buffer_length    = buffer_length;
+            _buffer_offset    = 0;
             rewind();
             set_speed(_speed);
             set_in(0);
             set_out(_buffer_length - 1);
             _loop_in  = NO_LOOP_POINT;
             _loop_out = NO_LOOP_POINT;
+            update_loop_splice();
         }
 
         void interpolate_samples(bool const interpolate_samples) {
@@ -196,63 +215,60 @@ namespace klangwellen {
         }
 
         float process() {
-            if (_buffer_length == 0) {
-                notifyListeners(); // "buffer is empty"
-                return 0.0f;
+            if (_buffer_length > 0) {
+                validateInOutPoints();
             }
+            return process_sample(loop_splice_start());
+        }
 
-            if (!_is_playing) {
-                notifyListeners(); // "not playing"
-                return 0.0f;
-            }
-
-            validateInOutPoints();
-
-            _buffer_index += _direction_forward ? _step_size : -_step_size;
-            const int32_t mRoundedIndex = static_cast<int32_t>(_buffer_index);
-
-            const float   mFrac         = _buffer_index - mRoundedIndex;
-            const int32_t mCurrentIndex = wrapIndex(mRoundedIndex);
-            _buffer_index               = mCurrentIndex + mFrac;
-
-            if (_direction_forward ? (mCurrentIndex >= _out_point) : (mCurrentIndex <= _in_point)) {
-                notifyListeners(); // "reached end"
-                return 0.0f;
-            } else {
-                _is_flagged_done = false;
-            }
-
-            float mSample = convert_sample(_buffer[mCurrentIndex]);
-
-            /* interpolate */
-            if (_interpolate_samples) {
-                // TODO evaluate direction?
-                const int32_t mNextIndex  = wrapIndex(mCurrentIndex + 1);
-                const float   mNextSample = convert_sample(_buffer[mNextIndex]);
-                mSample                   = mSample * (1.0f - mFrac) + mNextSample * mFrac;
-                // mSample = interpolate_samples_linear(_buffer, _buffer_length, _buffer_index);
-                // mSample = interpolate_samples_cubic(_buffer, _buffer_length, _buffer_index);
+        /**
+         * fills buffer with samples. stretches of the buffer that are played forward without reaching loop points, edges
+         * or the out point are converted with the block functions of `PCMConversion`, all other samples are processed
+         * like `process()`.
+         */
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            if (_buffer_length > 0) {
+                validateInOutPoints();
             }
-            mSample *= _amplitude;
-
-            /* fade edges */
-            if (_edge_fade_padding > 0) {
-                const int32_t mRelativeIndex = _buffer_length - mCurrentIndex;
-                if (mCurrentIndex < _edge_fade_padding) {
-                    const float mFadeInAmount = static_cast<float>(mCurrentIndex) / _edge_fade_padding;
-                    mSample *= mFadeInAmount;
-                } else if (mRelativeIndex < _edge_fade_padding) {
-                    const float mFadeOutAmount = static_cast<float>(mRelativeIndex) / _edge_fade_padding;
-                    mSample *= mFadeOutAmount;
+            const int32_t mSpliceStart = loop_splice_start();
+            uint32_t      i            = 0;
+            while (i < buffer_length) {
+                const uint32_t mLength = process_block(signal_buffer + i, buffer_length - i, mSpliceStart);
+                if (mLength > 0) {
+                    i += mLength;
+                } else {
+                    signal_buffer[i++] = process_sample(mSpliceStart);
                 }
             }
-            return mSample;
         }
 
-        void process(float* signal_buffer, const uint32_t buffer_length) {
-            for (uint16_t i = 0; i < buffer_length; i++) {
-                signal_buffer[i] = process();
-            }
+        /**
+         * fills buffer with samples and triggers notes sample-accurately at the offsets of the scheduled events (
+         * i.e `KlangWellen::EVENT_NOTE_ON` calls `note_on()`, `KlangWellen::EVENT_NOTE_OFF` calls `note_off()` ). note on
+         * events with a note other than `ScheduledEvent::NO_NOTE` also set frequency and amplitude.
+         *
+         * @param events           events sorted by offset
+         * @param number_of_events number of events
+         * @return number of applied events ( see `process_scheduled_events()` )
+         */
+        uint32_t process(float*                signal_buffer,
+                         const uint32_t        buffer_length,
+                         const ScheduledEvent* events,
+                         const uint32_t        number_of_events) {
+            return process_scheduled_events(
+                buffer_length, events, number_of_events,
+                [&](const uint32_t offset, const uint32_t length) { process(signal_buffer + offset, length); },
+                [&](const ScheduledEvent& event) {
+                    if (event.type == KlangWellen::EVENT_NOTE_ON) {
+                        if (event.note == ScheduledEvent::NO_NOTE) {
+                            note_on();
+                        } else {
+                            note_on(event.note, event.velocity);
+                        }
+                    } else if (event.type == KlangWellen::EVENT_NOTE_OFF) {
+                        note_off();
+                    }
+                });
         }
 
         int32_t get_edge_fading() const {
@@ -283,11 +299,12 @@ namespace klangwellen {
             _evaluate_loop = true;
             _loop_in       = 0;
             _loop_out      = _buffer_length > 0 ? (_buffer_length - 1) : 0;
+            update_loop_splice();
         }
 
         void play() {
             _is_playing = true;
-            _recording.clear();
+            delete_recording();
         }
 
         void stop() {
@@ -308,19 +325,78 @@ namespace klangwellen {
 
         void delete_recording() {
             _recording.clear();
+            _recording_position = 0;
+            _recording_wrapped  = false;
+        }
+
+        /**
+         * sets a buffer to record into. the sampler does not take ownership of the buffers. recording into a buffer
+         * never allocates memory, recording stops once the buffer is full unless recording wrap is enabled.
+         * <p>
+         * `end_recording()` swaps the recorded buffer into playback without copying it. if a second buffer is provided
+         * the two buffers are used alternately ( i.e one is played back while the other one is recorded into ), which
+         * allows live looping without allocating memory. without a second buffer recording is disabled after
+         * `end_recording()` until a new recording buffer is set.
+         *
+         * @param buffer        buffer to record into
+         * @param capacity      length of buffer(s) in samples
+         * @param second_buffer optional second buffer with the same capacity
+         */
+        void set_recording_buffer(BUFFER_TYPE* buffer, const int32_t capacity, BUFFER_TYPE* second_buffer = nullptr) {
+            free_recording_buffers();
+            _recording_buffers[0]        = buffer;
+            _recording_buffers[1]        = second_buffer;
+            _recording_buffer            = buffer;
+            _recording_capacity          = buffer != nullptr ? capacity : 0;
+            _allocated_recording_buffers = false;
+            delete_recording();
+        }
+
+        /**
+         * allocates two recording buffers that are used alternately. see `set_recording_buffer()`.
+         *
+         * @param capacity maximum length of a recording in samples
+         */
+        void allocate_recording_buffer(const int32_t capacity) {
+            set_recording_buffer(new BUFFER_TYPE[capacity], capacity, new BUFFER_TYPE[capacity]);
+            _allocated_recording_buffers = true;
+        }
+
+        int32_t get_recording_capacity() const {
+            return _recording_capacity;
+        }
+
+        /**
+         * if enabled a full recording buffer is overwritten from the beginning ( i.e the buffer always holds the latest
+         * `get_recording_capacity()` samples ), otherwise recording stops once the buffer is full.
+         */
+        void enable_recording_wrap(const bool wrap) {
+            _recording_wrap = wrap;
+        }
+
+        bool is_recording_wrapping() const {
+            return _recording_wrap;
         }
 
         void record(float sample) {
             if (_is_recording) {
-                _recording.push_back(sample);
+                if (has_recording_buffer()) {
+                    record_sample(sample);
+                } else {
+                    _recording.push_back(convert_to_sample(sample));
+                }
             }
         }
 
         void record(const float* samples, int32_t num_samples) {
             if (_is_recording) {
-                for (int32_t i = 0; i < num_samples; i++) {
+                for (int32_t i = 0; i < num_samples && _is_recording; i++) {
                     const float sample = samples[i];
-                    _recording.push_back(sample);
+                    if (has_recording_buffer()) {
+                        record_sample(sample);
+                    } else {
+                        _recording.push_back(convert_to_sample(sample));
+                    }
                 }
             }
         }
@@ -330,20 +406,48 @@ namespace klangwellen {
         }
 
         int get_length_recording() {
+            if (has_recording_buffer()) {
+                return _recording_wrapped ? _recording_capacity : _recording_position;
+            }
             return _recording.size();
         }
 
+        /**
+         * ends recording and uses the recording as the playback buffer. if a recording buffer is set the buffer is
+         * swapped into playback without copying or allocating memory, otherwise the recording is copied into a newly
+         * allocated buffer. if the recording buffer wrapped, playback starts at the oldest sample ( see
+         * `get_buffer_offset()` ). loop points are kept and clamped to the length of the recording.
+         *
+         * @return length of recording in samples
+         */
         uint32_t end_recording() {
-            _is_recording                = false;
+            _is_recording = false;
+            if (_recording_buffers[0] != nullptr) {
+                if (_recording_buffer == nullptr) {
+                    return 0;
+                }
+                const int32_t mBufferLength = get_length_recording();
+                const int32_t mLoopIn       = _loop_in;
+                const int32_t mLoopOut      = _loop_out;
+                BUFFER_TYPE*  mRecording    = _recording_buffer;
+                set_buffer(mRecording, mBufferLength);
+                if (_recording_wrapped) {
+                    /* oldest sample first */
+                    _buffer_offset = _recording_position;
+                }
+                _loop_in  = std::min(mLoopIn, _buffer_length - 1);
+                _loop_out = std::min(mLoopOut, _buffer_length - 1);
+                update_loop_splice();
+                _recording_buffer = _recording_buffers[0] == mRecording ? _recording_buffers[1] : _recording_buffers[0];
+                delete_recording();
+                return mBufferLength;
+            }
             const int32_t mBufferLength = _recording.size();
-            float*        mBuffer       = new float[mBufferLength];
+            BUFFER_TYPE*  mBuffer       = new BUFFER_TYPE[mBufferLength];
             for (int32_t i = 0; i < mBufferLength; i++) {
                 mBuffer[i] = _recording[i];
             }
             _recording.clear();
-            if (_allocated_buffer) {
-                delete[] _buffer;
-            }
             set_buffer(mBuffer, mBufferLength);
             _allocated_buffer = true;
             return mBufferLength;
@@ -355,6 +459,7 @@ namespace klangwellen {
 
         void set_loop_in(const int32_t loop_in_point) {
             _loop_in = KlangWellen::clamp(loop_in_point, NO_LOOP_POINT, _buffer_length - 1);
+            update_loop_splice();
         }
 
         float get_loop_in_normalized() const {
@@ -374,6 +479,7 @@ namespace klangwellen {
 
         void set_loop_out(const int32_t loop_out_point) {
             _loop_out = KlangWellen::clamp(loop_out_point, NO_LOOP_POINT, _buffer_length - 1);
+            update_loop_splice();
         }
 
         float get_loop_out_normalized() const {
@@ -387,6 +493,33 @@ namespace klangwellen {
             set_loop_out(static_cast<int32_t>(loop_out_point_normalized * _buffer_length - 1));
         }
 
+        int32_t get_loop_crossfade() const {
+            return _loop_crossfade;
+        }
+
+        /**
+         * crossfades the end of the loop into the samples preceding the loop in point, which removes the click when
+         * jumping from loop out to loop in point. the crossfaded samples are precomputed into a splice buffer whenever
+         * the loop points change, so this method and the `set_loop_*` methods should not be called from the audio
+         * thread.
+         * <p>
+         * the crossfade is linear and only applies while looping forward. it is shortened to the number of samples
+         * available before the loop in point and to the length of the loop. no samples precede a loop in point of 0, so
+         * the crossfade is disabled in that case ( e.g after `set_looping()` ). for a full crossfade the loop in point
+         * must be at least `crossfade_length` samples into the buffer.
+         *
+         * @param crossfade_length length of crossfade in samples ( 0 disables crossfading )
+         */
+        void set_loop_crossfade(const int32_t crossfade_length) {
+            _loop_crossfade = crossfade_length > 0 ? crossfade_length : 0;
+            if (_loop_crossfade > _loop_splice_capacity) {
+                delete[] _loop_splice;
+                _loop_splice          = new float[_loop_crossfade];
+                _loop_splice_capacity = _loop_crossfade;
+            }
+            update_loop_splice();
+        }
+
         void note_on() {
             rewind();
             play();
@@ -434,10 +567,24 @@ namespace klangwellen {
     private:
         std::vector<SamplerListener*> _sampler_listeners;
         std::vector<BUFFER_TYPE>      _recording;
+        BUFFER_TYPE*                  _recording_buffers[2]        = {nullptr, nullptr};
+        BUFFER_TYPE*                  _recording_buffer            = nullptr;
+        int32_t                       _recording_capacity          = 0;
+        int32_t                       _recording_position          = 0;
+        bool                          _recording_wrap              = false;
+        bool                          _recording_wrapped           = false;
+        bool                          _allocated_recording_buffers = false;
+        float*                        _loop_splice                 = nullptr;
+        int32_t                       _loop_splice_capacity        = 0;
+        int32_t                       _loop_splice_length          = 0;
+        int32_t                       _loop_splice_in              = NO_LOOP_POINT;
+        int32_t                       _loop_splice_out             = NO_LOOP_POINT;
+        int32_t                       _loop_crossfade              = 0;
         const uint32_t                _sample_rate;
         float                         _amplitude;
         BUFFER_TYPE*                  _buffer;
         int32_t                       _buffer_length;
+        int32_t                       _buffer_offset = 0;
         float                         _buffer_index;
         bool                          _direction_forward;
         int32_t                       _edge_fade_padding;
@@ -456,6 +603,216 @@ namespace klangwellen {
         bool                          _is_recording;
         bool                          _allocated_buffer;
 
+        static constexpr uint32_t BLOCK_CONVERSION_LENGTH = 64;
+        static constexpr int32_t  NO_LOOP_SPLICE          = 0x7FFFFFFF;
+
+        /* loop points and in and out points must be validated before */
+        float process_sample(const int32_t splice_start) {
+            if (_buffer_length == 0) {
+                notifyListeners(); // "buffer is empty"
+                return 0.0f;
+            }
+
+            if (!_is_playing) {
+                notifyListeners(); // "not playing"
+                return 0.0f;
+            }
+
+            _buffer_index += _direction_forward ? _step_size : -_step_size;
+            const int32_t mRoundedIndex = static_cast<int32_t>(_buffer_index);
+
+            const float   mFrac         = _buffer_index - mRoundedIndex;
+            const int32_t mCurrentIndex = wrapIndex(mRoundedIndex);
+            _buffer_index               = mCurrentIndex + mFrac;
+
+            if (_direction_forward ? (mCurrentIndex >= _out_point) : (mCurrentIndex <= _in_point)) {
+                notifyListeners(); // "reached end"
+                return 0.0f;
+            } else {
+                _is_flagged_done = false;
+            }
+
+            float mSample = read_sample(mCurrentIndex, splice_start);
+
+            /* interpolate */
+            if (_interpolate_samples) {
+                // TODO evaluate direction?
+                const int32_t mNextIndex  = wrapIndex(mCurrentIndex + 1);
+                const float   mNextSample = read_sample(mNextIndex, splice_start);
+                mSample                   = mSample * (1.0f - mFrac) + mNextSample * mFrac;
+                // mSample = interpolate_samples_linear(_buffer, _buffer_length, _buffer_index);
+                // mSample = interpolate_samples_cubic(_buffer, _buffer_length, _buffer_index);
+            }
+            mSample *= _amplitude;
+
+            /* fade edges */
+            if (_edge_fade_padding > 0) {
+                const int32_t mRelativeIndex = _buffer_length - mCurrentIndex;
+                if (mCurrentIndex < _edge_fade_padding) {
+                    const float mFadeInAmount = static_cast<float>(mCurrentIndex) / _edge_fade_padding;
+                    mSample *= mFadeInAmount;
+                } else if (mRelativeIndex < _edge_fade_padding) {
+                    const float mFadeOutAmount = static_cast<float>(mRelativeIndex) / _edge_fade_padding;
+                    mSample *= mFadeOutAmount;
+                }
+            }
+            return mSample;
+        }
+
+
+        /* renders up to `buffer_length` samples from a converted copy of the buffer ( or from the buffer itself for float
+         * samples ) while all indices can be read without wrapping, splicing or fading. returns the number of rendered
+         * samples, 0 if `process()` is required. */
+        uint32_t process_block(float* signal_buffer, const uint32_t buffer_length, const int32_t splice_start) {
+            if (_buffer_length == 0 || !_is_playing || !_direction_forward || _step_size <= 0.0f) {
+                return 0;
+            }
+
+            /* last index that is neither wrapped, faded nor read from the loop splice */
+            int32_t mLastIndex = std::min(_out_point, splice_start - 1);
+            if (_evaluate_loop && _loop_in != NO_LOOP_POINT && _loop_out != NO_LOOP_POINT) {
+                mLastIndex = std::min(mLastIndex, _loop_out);
+            }
+            int32_t mFirstIndex = _in_point;
+            if (_edge_fade_padding > 0) {
+                mFirstIndex = std::max(mFirstIndex, _edge_fade_padding);
+                mLastIndex  = std::min(mLastIndex, _buffer_length - _edge_fade_padding);
+            }
+
+            const int32_t mFirstRead = static_cast<int32_t>(_buffer_index + _step_size);
+            if (mFirstRead < mFirstIndex || mFirstRead >= _out_point) {
+                return 0;
+            }
+
+            const int32_t mPosition = buffer_position(mFirstRead);
+            const float*  mSamples;
+            int32_t       mLastRead;
+            float         mConvertedSamples[BLOCK_CONVERSION_LENGTH];
+            if constexpr (std::is_same<BUFFER_TYPE, float>::value) {
+                /* read in place up to the end of the buffer, a wrapped recording continues at its start */
+                mLastRead = std::min(mLastIndex, mFirstRead + (_buffer_length - mPosition) - 1);
+                mSamples  = _buffer + mPosition;
+                if (mLastRead <= mFirstRead) {
+                    return 0;
+                }
+            } else {
+                /* large steps read too few samples from a converted block to pay for the conversion */
+                mLastRead = std::min(mFirstRead + static_cast<int32_t>(BLOCK_CONVERSION_LENGTH) - 1, mLastIndex);
+                if (_step_size >= BLOCK_CONVERSION_LENGTH / 2 || mLastRead <= mFirstRead) {
+                    return 0;
+                }
+                const int32_t mLength      = mLastRead - mFirstRead + 1;
+                const int32_t mFirstLength = std::min(mLength, _buffer_length - mPosition);
+                convert_samples(_buffer + mPosition, mConvertedSamples, mFirstLength);
+                convert_samples(_buffer, mConvertedSamples + mFirstLength, mLength - mFirstLength);
+                mSamples = mConvertedSamples;
+            }
+
+            uint32_t i = 0;
+            for (; i < buffer_length; i++) {
+                const float   mBufferIndex = _buffer_index + _step_size;
+                const int32_t mIndex       = static_cast<int32_t>(mBufferIndex);
+                /* the next index is read for interpolation and must not reach the out point ( i.e end of playback ) */
+                if (mIndex + 1 > mLastRead || mIndex >= _out_point) {
+                    break;
+                }
+                const float mFrac = mBufferIndex - mIndex;
+                float       mSample;
+                if (_interpolate_samples) {
+                    mSample = mSamples[mIndex - mFirstRead] * (1.0f - mFrac) + mSamples[mIndex - mFirstRead + 1] * mFrac;
+                } else {
+                    mSample = mSamples[mIndex - mFirstRead];
+                }
+                signal_buffer[i] = mSample * _amplitude;
+                _buffer_index    = mBufferIndex;
+            }
+            if (i > 0) {
+                _is_flagged_done = false;
+            }
+            return i;
+        }
+
+        /* first index that is read from the loop splice or `NO_LOOP_SPLICE`. evaluated once per block, the splice is only
+         * valid for the loop points it was computed for. */
+        int32_t loop_splice_start() const {
+            if (_loop_splice_length > 0 && _evaluate_loop && _direction_forward &&
+                _loop_in == _loop_splice_in && _loop_out == _loop_splice_out) {
+                return _loop_out - _loop_splice_length + 1;
+            }
+            return NO_LOOP_SPLICE;
+        }
+
+        float read_sample(const int32_t index, const int32_t splice_start) const {
+            const uint32_t mSpliceIndex = static_cast<uint32_t>(index - splice_start);
+            if (mSpliceIndex < static_cast<uint32_t>(_loop_splice_length)) {
+                return _loop_splice[mSpliceIndex];
+            }
+            return convert_sample(_buffer[buffer_position(index)]);
+        }
+
+        /* maps an index to its position in the buffer, which is rotated by the buffer offset */
+        int32_t buffer_position(const int32_t index) const {
+            const int32_t mPosition = index + _buffer_offset;
+            return mPosition < _buffer_length ? mPosition : mPosition - _buffer_length;
+        }
+
+        void update_loop_splice() {
+            _loop_splice_length = 0;
+            _loop_splice_in     = _loop_in;
+            _loop_splice_out    = _loop_out;
+            if (_loop_crossfade == 0 || _buffer == nullptr || _loop_in == NO_LOOP_POINT || _loop_out == NO_LOOP_POINT || _loop_out < _loop_in) {
+                return;
+            }
+            const int32_t mLength = std::min(std::min(_loop_crossfade, _loop_in), _loop_out - _loop_in + 1);
+            const int32_t mStart  = _loop_out - mLength + 1;
+            const int32_t mOffset = _loop_out - _loop_in + 1;
+            for (int32_t i = 0; i < mLength; i++) {
+                /* fades from the end of the loop into the samples before the loop in point */
+                const float mFade = static_cast<float>(i + 1) / mLength;
+                const float a     = convert_sample(_buffer[buffer_position(mStart + i)]);
+                const float b     = convert_sample(_buffer[buffer_position(mStart + i - mOffset)]);
+                _loop_splice[i]   = a * (1.0f - mFade) + b * mFade;
+            }
+            _loop_splice_length = mLength;
+        }
+
+        bool has_recording_buffer() const {
+            return _recording_buffers[0] != nullptr;
+        }
+
+        void record_sample(const float sample) {
+            if (_recording_buffer == nullptr) {
+                _is_recording = false;
+                return;
+            }
+            _recording_buffer[_recording_position++] = convert_to_sample(sample);
+            if (_recording_position >= _recording_capacity) {
+                if (_recording_wrap) {
+                    _recording_position = 0;
+                    _recording_wrapped  = true;
+                } else {
+                    _is_recording = false;
+                }
+            }
+        }
+
+        void free_recording_buffers() {
+            if (_allocated_recording_buffers) {
+                for (BUFFER_TYPE* mBuffer: _recording_buffers) {
+                    if (mBuffer == _buffer) {
+                        /* keep buffer that is currently played back alive */
+                        _allocated_buffer = true;
+                    } else {
+                        delete[] mBuffer;
+                    }
+                }
+            }
+            _recording_buffers[0]        = nullptr;
+            _recording_buffers[1]        = nullptr;
+            _recording_buffer            = nullptr;
+            _allocated_recording_buffers = false;
+        }
+
         int32_t last_index() const {
             return _buffer_length - 1;
         }
@@ -516,44 +873,80 @@ namespace klangwellen {
             return i;
         }
 
+    public:
         static float convert_sample(const BUFFER_TYPE pRawSample) {
             return pRawSample;
         }
+
+        static void convert_samples(const BUFFER_TYPE* raw_samples, float* samples, const uint32_t length) {
+            for (uint32_t i = 0; i < length; i++) {
+                samples[i] = convert_sample(raw_samples[i]);
+            }
+        }
+
+        static BUFFER_TYPE convert_to_sample(const float sample) {
+            return sample;
+        }
     };
 
     template<>
     inline float klangwellen::SamplerT<uint8_t>::convert_sample(const uint8_t pRawSample) {
-        constexpr static float mScale = 1.0 / ((1 << 8) - 1);
-        const float            mRange = pRawSample * mScale;
-        return mRange * 2.0 - 1.0;
+        return PCMConversion::to_float(pRawSample);
     }
 
     template<>
     inline float klangwellen::SamplerT<int8_t>::convert_sample(const int8_t pRawSample) {
-        constexpr static float mScale  = 1.0 / ((1 << 8) - 1);
-        const float            mOffset = pRawSample + (1 << 7);
-        const float            mRange  = mOffset * mScale;
-        return mRange * 2.0 - 1.0;
+        return PCMConversion::to_float(pRawSample);
     }
 
     template<>
     inline float klangwellen::SamplerT<uint16_t>::convert_sample(const uint16_t pRawSample) {
-        constexpr static float mScale = 1.0 / ((1 << 16) - 1);
-        const float            mRange = pRawSample * mScale;
-        return mRange * 2.0 - 1.0;
-        // @note(below: less precise but faster)
-        // const float s      = pRawSample;
-        // static const float mScale = 1.0 / (1 << 15);
-        // const float a      = s * mScale - 1.0;
-        // return a;
+        return PCMConversion::to_float(pRawSample);
     }
 
     template<>
     inline float klangwellen::SamplerT<int16_t>::convert_sample(const int16_t pRawSample) {
-        constexpr static float mScale  = 1.0 / ((1 << 16) - 1);
-        const float            mOffset = pRawSample + (1 << 15);
-        const float            mRange  = mOffset * mScale;
-        return mRange * 2.0 - 1.0;
+        return PCMConversion::to_float(pRawSample);
+    }
+
+    template<>
+    inline void klangwellen::SamplerT<uint8_t>::convert_samples(const uint8_t* raw_samples, float* samples, const uint32_t length) {
+        PCMConversion::to_float(raw_samples, samples, length);
+    }
+
+    template<>
+    inline void klangwellen::SamplerT<int8_t>::convert_samples(const int8_t* raw_samples, float* samples, const uint32_t length) {
+        PCMConversion::to_float(raw_samples, samples, length);
+    }
+
+    template<>
+    inline void klangwellen::SamplerT<uint16_t>::convert_samples(const uint16_t* raw_samples, float* samples, const uint32_t length) {
+        PCMConversion::to_float(raw_samples, samples, length);
+    }
+
+    template<>
+    inline void klangwellen::SamplerT<int16_t>::convert_samples(const int16_t* raw_samples, float* samples, const uint32_t length) {
+        PCMConversion::to_float(raw_samples, samples, length);
+    }
+
+    template<>
+    inline uint8_t klangwellen::SamplerT<uint8_t>::convert_to_sample(const float sample) {
+        return PCMConversion::to_uint8(sample);
+    }
+
+    template<>
+    inline int8_t klangwellen::SamplerT<int8_t>::convert_to_sample(const float sample) {
+        return PCMConversion::to_int8(sample);
+    }
+
+    template<>
+    inline uint16_t klangwellen::SamplerT<uint16_t>::convert_to_sample(const float sample) {
+        return PCMConversion::to_uint16(sample);
+    }
+
+    template<>
+    inline int16_t klangwellen::SamplerT<int16_t>::convert_to_sample(const float sample) {
+        return PCMConversion::to_int16(sample);
     }
 
     using SamplerUI8  = SamplerT<uint8_t>;
@@ -0,0 +1,452 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * PROCESSOR INTERFACE
+ *
+ * - [x] float process()
+ * - [ ] float process(float)
+ * - [ ] void process(AudioSignal&)
+ * - [x] void process(float*, uint32_t) *overwrite*
+ * - [ ] void process(float*, float*, uint32_t)
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "KlangWellen.h"
+#include "Sampler.h"
+
+namespace klangwellen {
+    /**
+     * polyphonic sampler that plays a single, shared sample buffer with a fixed number of voices. all voices are
+     * preallocated with the pool, no memory is allocated after construction. voices are triggered with `note_on` and
+     * released with `note_off`. if all voices are busy a voice is stolen according to the voice stealing strategy (
+     * i.e `KlangWellen::VOICE_STEALING_OLDEST` or `KlangWellen::VOICE_STEALING_QUIETEST` ). released voices are stolen
+     * before voices that are still held. a stolen ( or retriggered ) voice fades out its previous note over a few
+     * milliseconds instead of cutting it off.
+     * <p>
+     * while a note is held a voice loops between loop in- and output point ( if both are set ). once a note is released
+     * the voice plays until the output point is reached.
+     */
+    template<class BUFFER_TYPE, uint8_t NUMBER_OF_VOICES>
+    class SamplerVoicePoolT {
+    public:
+        static constexpr int8_t NO_LOOP_POINT = -1;
+        static constexpr int8_t NO_VOICE      = -1;
+
+        explicit SamplerVoicePoolT(const uint32_t sample_rate) : SamplerVoicePoolT(nullptr, 0, sample_rate) {}
+
+        SamplerVoicePoolT(BUFFER_TYPE*   buffer,
+                          const int32_t  buffer_length,
+                          const uint32_t sample_rate) : _sample_rate(sample_rate),
+                                                        _buffer_sample_rate(sample_rate),
+                                                        _amplitude(1.0f),
+                                                        _base_frequency(KlangWellen::midi_note_to_frequency(DEFAULT_ROOT_NOTE)),
+                                                        _interpolate_samples(false),
+                                                        _voice_stealing(KlangWellen::VOICE_STEALING_OLDEST),
+                                                        _voice_counter(0),
+                                                        _steal_fade_length(std::max(static_cast<uint32_t>(STEAL_FADE_DURATION * sample_rate), static_cast<uint32_t>(1))) {
+            set_buffer(buffer, buffer_length);
+        }
+
+        /**
+         * sets the sample buffer shared by all voices. the buffer is not copied and not owned by the pool. all playing
+         * voices are stopped and in-, out- and loop points are reset.
+         */
+        void set_buffer(BUFFER_TYPE* buffer, const int32_t buffer_length) {
+            _buffer        = buffer;
+            _buffer_length = buffer == nullptr ? 0 : buffer_length;
+            _in_point      = 0;
+            _out_point     = _buffer_length > 0 ? _buffer_length - 1 : 0;
+            _loop_in       = NO_LOOP_POINT;
+            _loop_out      = NO_LOOP_POINT;
+            stop();
+        }
+
+        BUFFER_TYPE* get_buffer() const {
+            return _buffer;
+        }
+
+        int32_t get_buffer_length() const {
+            return _buffer_length;
+        }
+
+        /**
+         * @param buffer_sample_rate sample rate of the sample buffer if it differs from the sample rate of the pool (
+         *                           e.g a sample recorded at 44100Hz played back at 48000Hz )
+         */
+        void set_buffer_sample_rate(const uint32_t buffer_sample_rate) {
+            _buffer_sample_rate = buffer_sample_rate;
+        }
+
+        uint32_t get_buffer_sample_rate() const {
+            return _buffer_sample_rate;
+        }
+
+        int32_t get_in() const {
+            return _in_point;
+        }
+
+        void set_in(const int32_t in_point) {
+            _in_point = KlangWellen::clamp(in_point, static_cast<int32_t>(0), _out_point);
+        }
+
+        int32_t get_out() const {
+            return _out_point;
+        }
+
+        void set_out(const int32_t out_point) {
+            _out_point = KlangWellen::clamp(out_point, _in_point, last_index());
+        }
+
+        int32_t get_loop_in() const {
+            return _loop_in;
+        }
+
+        void set_loop_in(const int32_t loop_in_point) {
+            _loop_in = KlangWellen::clamp(loop_in_point, static_cast<int32_t>(NO_LOOP_POINT), last_index());
+        }
+
+        int32_t get_loop_out() const {
+            return _loop_out;
+        }
+
+        void set_loop_out(const int32_t loop_out_point) {
+            _loop_out = KlangWellen::clamp(loop_out_point, static_cast<int32_t>(NO_LOOP_POINT), last_index());
+        }
+
+        void set_looping() {
+            _loop_in  = _in_point;
+            _loop_out = _out_point;
+        }
+
+        float get_amplitude() const {
+            return _amplitude;
+        }
+
+        /**
+         * @param amplitude master amplitude applied to all voices
+         */
+        void set_amplitude(const float amplitude) {
+            _amplitude = amplitude;
+        }
+
+        void interpolate_samples(const bool interpolate_samples) {
+            _interpolate_samples = interpolate_samples;
+        }
+
+        bool interpolate_samples() const {
+            return _interpolate_samples;
+        }
+
+        /**
+         * @param voice_stealing either `KlangWellen::VOICE_STEALING_OLDEST` or `KlangWellen::VOICE_STEALING_QUIETEST`
+         */
+        void set_voice_stealing(const uint8_t voice_stealing) {
+            _voice_stealing = voice_stealing;
+        }
+
+        uint8_t get_voice_stealing() const {
+            return _voice_stealing;
+        }
+
+        /**
+         * tunes the sample buffer to a specific frequency i.e a note played at this frequency plays the sample buffer at
+         * its original speed.
+         *
+         * @param tune_frequency the assumed frequency of the sample buffer in Hz
+         */
+        void tune_frequency_to(const float tune_frequency) {
+            if (tune_frequency > 0.0f) {
+                _base_frequency = tune_frequency;
+            }
+        }
+
+        /**
+         * @param root_note MIDI note at which the sample buffer is played at its original speed ( default: `60` )
+         */
+        void set_root_note(const uint8_t root_note) {
+            tune_frequency_to(KlangWellen::midi_note_to_frequency(root_note));
+        }
+
+        /**
+         * triggers a voice. if the note is already playing the voice is retriggered, otherwise a free voice is used or,
+         * if all voices are busy, a voice is stolen.
+         *
+         * @return index of the triggered voice or `NO_VOICE` if no buffer is set
+         */
+        int8_t note_on(const uint8_t note, const uint8_t velocity) {
+            return note_on(note, velocity, KlangWellen::midi_note_to_frequency(note));
+        }
+
+        /**
+         * @param frequency playback frequency of the voice in Hz ( see `tune_frequency_to` )
+         */
+        int8_t note_on(const uint8_t note, const uint8_t velocity, const float frequency) {
+            if (_buffer_length == 0) {
+                return NO_VOICE;
+            }
+            const uint8_t mIndex = find_voice(note);
+            Voice&        mVoice = _voices[mIndex];
+            if (mVoice.is_active) {
+                /* fade out the previous note of a stolen or retriggered voice */
+                mVoice.fade_position  = mVoice.position;
+                mVoice.fade_step_size = mVoice.step_size;
+                mVoice.fade_amplitude = mVoice.amplitude;
+                mVoice.fade_remaining = _steal_fade_length;
+                mVoice.fade_loop      = mVoice.is_note_held && has_loop();
+            } else {
+                mVoice.fade_remaining = 0;
+            }
+            mVoice.note          = note;
+            mVoice.amplitude     = KlangWellen::clamp127(velocity) / 127.0f;
+            mVoice.step_size     = frequency / _base_frequency * (static_cast<float>(_buffer_sample_rate) / static_cast<float>(_sample_rate));
+            mVoice.position      = static_cast<float>(_in_point);
+            mVoice.level         = mVoice.amplitude * _amplitude;
+            mVoice.age           = _voice_counter++;
+            mVoice.is_active     = true;
+            mVoice.is_note_held  = true;
+            return static_cast<int8_t>(mIndex);
+        }
+
+        /**
+         * releases all voices playing the note. released voices stop looping and play until the output point.
+         */
+        void note_off(const uint8_t note) {
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                if (_voices[i].is_active && _voices[i].note == note) {
+                    _voices[i].is_note_held = false;
+                }
+            }
+        }
+
+        void note_off() {
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                _voices[i].is_note_held = false;
+            }
+        }
+
+        /**
+         * immediately silences all voices.
+         */
+        void stop() {
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                _voices[i].is_active      = false;
+                _voices[i].is_note_held   = false;
+                _voices[i].level          = 0.0f;
+                _voices[i].fade_remaining = 0;
+            }
+        }
+
+        bool is_voice_active(const uint8_t voice) const {
+            return voice < NUMBER_OF_VOICES && _voices[voice].is_active;
+        }
+
+        uint8_t get_number_of_active_voices() const {
+            uint8_t mActiveVoices = 0;
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                mActiveVoices += _voices[i].is_active ? 1 : 0;
+            }
+            return mActiveVoices;
+        }
+
+        static constexpr uint8_t get_number_of_voices() {
+            return NUMBER_OF_VOICES;
+        }
+
+        float process() {
+            float mSample;
+            process(&mSample, 1);
+            return mSample;
+        }
+
+        /**
+         * renders and mixes all active voices into the signal buffer. inactive voices cost nothing.
+         */
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            std::fill_n(signal_buffer, buffer_length, 0.0f);
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                /* the fade of a stolen note continues even if the new note has ended */
+                if (_voices[i].fade_remaining > 0) {
+                    render_fade(_voices[i], signal_buffer, buffer_length);
+                }
+                if (_voices[i].is_active) {
+                    render_voice(_voices[i], signal_buffer, buffer_length);
+                }
+            }
+        }
+
+    private:
+        static constexpr uint8_t DEFAULT_ROOT_NOTE   = 60;
+        static constexpr float   STEAL_FADE_DURATION = 0.002f;
+
+        struct Voice {
+            float    position       = 0.0f;
+            float    step_size      = 1.0f;
+            float    amplitude      = 0.0f;
+            float    level          = 0.0f; /* peak of the last rendered block, used to find the quietest voice */
+            uint32_t age            = 0;
+            uint8_t  note           = 0;
+            bool     is_active      = false;
+            bool     is_note_held   = false;
+            /* previous note of a stolen voice that is faded out */
+            float    fade_position  = 0.0f;
+            float    fade_step_size = 0.0f;
+            float    fade_amplitude = 0.0f;
+            uint32_t fade_remaining = 0;
+            bool     fade_loop      = false;
+        };
+
+        const uint32_t _sample_rate;
+        uint32_t       _buffer_sample_rate;
+        Voice          _voices[NUMBER_OF_VOICES];
+        BUFFER_TYPE*   _buffer;
+        int32_t        _buffer_length;
+        int32_t        _in_point;
+        int32_t        _out_point;
+        int32_t        _loop_in;
+        int32_t        _loop_out;
+        float          _amplitude;
+        float          _base_frequency;
+        bool           _interpolate_samples;
+        uint8_t        _voice_stealing;
+        uint32_t       _voice_counter;
+        const uint32_t _steal_fade_length;
+
+        int32_t last_index() const {
+            return _buffer_length > 0 ? _buffer_length - 1 : 0;
+        }
+
+        bool has_loop() const {
+            return _loop_in != NO_LOOP_POINT && _loop_out != NO_LOOP_POINT && _loop_in < _loop_out;
+        }
+
+        uint8_t find_voice(const uint8_t note) const {
+            /* retrigger voice already playing the note */
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                if (_voices[i].is_active && _voices[i].note == note) {
+                    return i;
+                }
+            }
+            /* use free voice */
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                if (!_voices[i].is_active) {
+                    return i;
+                }
+            }
+            /* steal voice, released voices first */
+            uint8_t mStolenVoice = NUMBER_OF_VOICES;
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                if (mStolenVoice == NUMBER_OF_VOICES || is_better_to_steal(_voices[i], _voices[mStolenVoice])) {
+                    mStolenVoice = i;
+                }
+            }
+            return mStolenVoice;
+        }
+
+        bool is_better_to_steal(const Voice& candidate, const Voice& stolen) const {
+            if (candidate.is_note_held != stolen.is_note_held) {
+                return !candidate.is_note_held;
+            }
+            if (_voice_stealing == KlangWellen::VOICE_STEALING_QUIETEST) {
+                return candidate.level < stolen.level ||
+                       (candidate.level == stolen.level && is_older(candidate, stolen));
+            }
+            return is_older(candidate, stolen);
+        }
+
+        bool is_older(const Voice& a, const Voice& b) const {
+            /* compare relative to counter to survive wrap around */
+            return (_voice_counter - a.age) > (_voice_counter - b.age);
+        }
+
+        float read_sample(const float position, const int32_t index) const {
+            float mSample = SamplerT<BUFFER_TYPE>::convert_sample(_buffer[index]);
+            if (_interpolate_samples) {
+                const float mFrac       = position - index;
+                const float mNextSample = SamplerT<BUFFER_TYPE>::convert_sample(_buffer[index + 1]);
+                mSample += mFrac * (mNextSample - mSample);
+            }
+            return mSample;
+        }
+
+        void render_voice(Voice& voice, float* signal_buffer, const uint32_t buffer_length) const {
+            const bool    mLoop       = voice.is_note_held && has_loop();
+            const float   mLoopIn     = static_cast<float>(_loop_in);
+            const float   mLoopLength = static_cast<float>(_loop_out - _loop_in);
+            const float   mAmplitude  = voice.amplitude * _amplitude;
+            float         mPosition   = voice.position;
+            const float   mStepSize   = voice.step_size;
+            const int32_t mOutPoint   = _out_point;
+            float         mPeak       = 0.0f;
+
+            for (uint32_t i = 0; i < buffer_length; i++) {
+                if (mLoop && mPosition >= _loop_out) {
+                    /* wrap steps that are larger than the loop as well */
+                    mPosition = mLoopIn + fmodf(mPosition - mLoopIn, mLoopLength);
+                }
+                const int32_t mIndex = static_cast<int32_t>(mPosition);
+                if (mIndex >= mOutPoint) {
+                    voice.is_active = false;
+                    break;
+                }
+                const float mSample = read_sample(mPosition, mIndex) * mAmplitude;
+                signal_buffer[i] += mSample;
+                mPeak = std::max(mPeak, fabsf(mSample));
+                mPosition += mStepSize;
+            }
+            voice.position = mPosition;
+            voice.level    = mPeak;
+        }
+
+        /* fades out the previous note of a stolen voice linearly */
+        void render_fade(Voice& voice, float* signal_buffer, const uint32_t buffer_length) const {
+            const uint32_t mLength     = std::min(voice.fade_remaining, buffer_length);
+            const float    mFadeStep   = voice.fade_amplitude * _amplitude / static_cast<float>(_steal_fade_length);
+            const bool     mLoop       = voice.fade_loop && has_loop();
+            const float    mLoopIn     = static_cast<float>(_loop_in);
+            const float    mLoopLength = static_cast<float>(_loop_out - _loop_in);
+            for (uint32_t i = 0; i < mLength; i++) {
+                if (mLoop && voice.fade_position >= _loop_out) {
+                    voice.fade_position = mLoopIn + fmodf(voice.fade_position - mLoopIn, mLoopLength);
+                }
+                const int32_t mIndex = static_cast<int32_t>(voice.fade_position);
+                if (mIndex >= _out_point) {
+                    voice.fade_remaining = 0;
+                    return;
+                }
+                signal_buffer[i] += read_sample(voice.fade_position, mIndex) * mFadeStep * static_cast<float>(voice.fade_remaining - i);
+                voice.fade_position += voice.fade_step_size;
+            }
+            voice.fade_remaining -= mLength;
+        }
+    };
+
+    template<uint8_t NUMBER_OF_VOICES>
+    using SamplerVoicePoolI16 = SamplerVoicePoolT<int16_t, NUMBER_OF_VOICES>;
+    template<uint8_t NUMBER_OF_VOICES>
+    using SamplerVoicePoolF32 = SamplerVoicePoolT<float, NUMBER_OF_VOICES>;
+    template<uint8_t NUMBER_OF_VOICES>
+    using SamplerVoicePool = SamplerVoicePoolT<float, NUMBER_OF_VOICES>;
+} // namespace klangwellen
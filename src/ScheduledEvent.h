@@ -0,0 +1,86 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "KlangWellen.h"
+
+namespace klangwellen {
+    /**
+     * event that takes effect at a specific sample within a block. processors that accept a list of scheduled events
+     * ( e.g `ADSR`, `Envelope` or `SamplerT` ) split the block at the event offsets so that note on and note off events
+     * are applied sample-accurately instead of at the block boundary:
+     * <pre>
+     * <code>
+     *     ScheduledEvent mEvents[] = {{12, KlangWellen::EVENT_NOTE_ON}, {200, KlangWellen::EVENT_NOTE_OFF}};
+     *     mADSR.process(mBuffer, 256, mEvents, 2);
+     * </code>
+     * </pre>
+     */
+    struct ScheduledEvent {
+        static constexpr uint8_t NO_NOTE = 0xFF;
+
+        /**
+         * sample offset of the event relative to the start of the block
+         */
+        uint32_t offset   = 0;
+        /**
+         * type of the event, either `KlangWellen::EVENT_NOTE_ON` or `KlangWellen::EVENT_NOTE_OFF`
+         */
+        int      type     = KlangWellen::EVENT_NOTE_ON;
+        /**
+         * MIDI note of the event or `NO_NOTE` if the event does not change the pitch
+         */
+        uint8_t  note     = NO_NOTE;
+        uint8_t  velocity = 127;
+    };
+
+    /**
+     * splits a block at the offsets of a list of events. `process_segment(offset, length)` is called for every segment
+     * between two events and `apply_event(event)` is called at the offset of each event. events must be sorted by offset.
+     *
+     * @return number of applied events. events with an offset at or beyond the end of the block are not applied, they
+     * can be submitted with the next block at `offset - buffer_length`.
+     */
+    template<typename PROCESS_SEGMENT, typename APPLY_EVENT>
+    uint32_t process_scheduled_events(const uint32_t        buffer_length,
+                                  const ScheduledEvent* events,
+                                  const uint32_t        number_of_events,
+                                  PROCESS_SEGMENT&&     process_segment,
+                                  APPLY_EVENT&&         apply_event) {
+        uint32_t mOffset = 0;
+        uint32_t i       = 0;
+        for (; i < number_of_events && events[i].offset < buffer_length; i++) {
+            const uint32_t mEventOffset = std::max(mOffset, events[i].offset);
+            if (mEventOffset > mOffset) {
+                process_segment(mOffset, mEventOffset - mOffset);
+                mOffset = mEventOffset;
+            }
+            apply_event(events[i]);
+        }
+        if (mOffset < buffer_length) {
+            process_segment(mOffset, buffer_length - mOffset);
+        }
+        return i;
+    }
+} // namespace klangwellen
@@ -30,7 +30,11 @@
 #pragma once
 
 #include <stdint.h>
-#include <iostream>
+
+#include <algorithm>
+#include <atomic>
+
+#include "SPSCRingBuffer.h"
 
 namespace klangwellen {
     class StreamDataProvider {
@@ -40,15 +44,47 @@ namespace klangwellen {
         virtual void fill_buffer(float* buffer, const uint32_t length) {
             std::fill_n(buffer, length, 0.0f);
         }
+
+        /**
+         * restarts the data at `frame`. called by `Stream::reset()` before the stream buffer is refilled ( in
+         * asynchronous mode from the worker thread ). `frame` is only larger than 0 if the provider has a head, the frames
+         * before it are then copied from the head.
+         */
+        virtual void seek(const uint32_t frame) {}
+
+        /**
+         * @return number of frames at the beginning of the data that are kept in memory ( e.g a preloaded file head )
+         */
+        virtual uint32_t get_head_length() const {
+            return 0;
+        }
+
+        /**
+         * copies frames from the head. in asynchronous mode this is called by `Stream::reset()` from the audio thread, so
+         * it must not block.
+         */
+        virtual void fill_head(float* buffer, const uint32_t offset, const uint32_t length) const {}
     };
 
+    /**
+     * plays back a continuous stream of samples supplied by a `StreamDataProvider`. the stream buffer is divided into
+     * segments, whenever playback crosses a segment border a previous segment is refilled from the provider.
+     * <p>
+     * by default segments are refilled synchronously inside `process()`. in asynchronous mode refills are posted
+     * through a wait-free queue to a worker thread ( see `StreamRefillWorker` ) that calls `service()`, so the audio
+     * thread never runs provider code. samples of segments that are not refilled in time are replaced with silence and
+     * counted as underruns. `reset()` starts a new generation of the stream: segments covered by the head of the
+     * provider are copied right away, the worker thread refills the remaining segments in order while refill requests
+     * of previous generations are dropped.
+     */
     class Stream final {
     public:
         Stream(StreamDataProvider* stream_data_provider,
                const uint32_t      sample_rate,
                const uint32_t      stream_buffer_size,
                const uint8_t       stream_buffer_division      = 4,
-               const uint8_t       stream_buffer_update_offset = 1)
+               const uint8_t       stream_buffer_update_offset = 1,
+               const bool          asynchronous                = false)
             : _stream_data_provider(stream_data_provider),
               _buffer_length(stream_buffer_size),
               _buffer(new float[stream_buffer_size]),
@@ -60,12 +96,33 @@ namespace klangwellen {
               _interpolate_samples(true),
               _buffer_index(0.0f),
               _buffer_index_prev(0.0f),
-              _complete_event(NO_EVENT) {
+              _complete_event(NO_EVENT),
+              _asynchronous(asynchronous),
+              _segment_length(stream_buffer_size / stream_buffer_division),
+              _segment_generation(asynchronous ? new std::atomic<uint32_t>[stream_buffer_division] : nullptr),
+              _requested_generation(asynchronous ? new uint32_t[stream_buffer_division] : nullptr),
+              _unqueued_requests(asynchronous ? new bool[stream_buffer_division] : nullptr),
+              _has_unqueued_requests(false),
+              _refill_requests(asynchronous ? new SPSCRingBuffer<RefillRequest>(stream_buffer_division * REFILL_QUEUE_GENERATIONS) : nullptr),
+              _generation(0),
+              _serviced_generation(0),
+              _underruns(0) {
             _stream_data_provider->fill_buffer(_buffer, _buffer_length);
+            if (_asynchronous) {
+                for (uint8_t i = 0; i < _buffer_division; i++) {
+                    _segment_generation[i].store(0, std::memory_order_relaxed);
+                    _requested_generation[i] = NO_GENERATION;
+                    _unqueued_requests[i]    = false;
+                }
+            }
         }
 
         ~Stream() {
             delete[] _buffer;
+            delete[] _segment_generation;
+            delete[] _requested_generation;
+            delete[] _unqueued_requests;
+            delete _refill_requests;
         }
 
         float process() {
@@ -75,26 +132,37 @@ namespace klangwellen {
             const int32_t mCurrentIndex = wrapIndex(mRoundedIndex);
             _buffer_index               = mCurrentIndex + mFrac;
 
-            float mSample = convert_sample(_buffer[mCurrentIndex]);
+            bool  mMissing = false;
+            float mSample  = read_sample(mCurrentIndex, mMissing);
 
             /* linear interpolation */
             if (_interpolate_samples) {
                 const int32_t mNextIndex  = wrapIndex(mCurrentIndex + 1);
-                const float   mNextSample = convert_sample(_buffer[mNextIndex]);
+                const float   mNextSample = read_sample(mNextIndex, mMissing);
                 const float   a           = mSample * (1.0f - mFrac);
                 const float   b           = mNextSample * mFrac;
                 mSample                   = a + b;
             }
             mSample *= _amplitude;
+            if (mMissing) {
+                _underruns.fetch_add(1, std::memory_order_relaxed);
+            }
 
             /* load next block */
+            if (_has_unqueued_requests) {
+                queue_unqueued_requests();
+            }
             int8_t mCompleteEvent = checkCompleteEvent(_buffer_division);
             if (mCompleteEvent > NO_EVENT) {
                 _complete_event = mCompleteEvent;
                 mCompleteEvent -= _buffer_segment_offset;
                 mCompleteEvent += _buffer_division;
                 mCompleteEvent %= _buffer_division;
-                replace_segment(_buffer_division, mCompleteEvent);
+                if (_asynchronous) {
+                    request_segment(mCompleteEvent);
+                } else {
+                    replace_segment(_buffer_division, mCompleteEvent);
+                }
             }
             _buffer_index_prev = _buffer_index;
 
@@ -103,7 +171,6 @@ namespace klangwellen {
 
         void replace_segment(const uint32_t number_of_segments, const uint32_t segment_index) const {
             if (segment_index >= number_of_segments) {
-                std::cerr << "Segment index out of range" << std::endl;
                 return;
             }
 
@@ -113,6 +180,78 @@ namespace klangwellen {
             _stream_data_provider->fill_buffer(startOfSegment, lengthOfSegment);
         }
 
+        /**
+         * rewinds the stream and its data provider to the beginning and refills the entire buffer from the data provider.
+         * in asynchronous mode only the segments covered by the head of the data provider are refilled right away (
+         * see `StreamDataProvider::get_head_length()` ), the remaining segments are refilled by the worker thread and
+         * are not ready until then ( see `is_ready()` ).
+         */
+        void reset() {
+            _buffer_index      = 0.0f;
+            _buffer_index_prev = 0.0f;
+            _complete_event    = NO_EVENT;
+            if (_asynchronous) {
+                const uint32_t mGeneration = _generation.load(std::memory_order_relaxed) + 1;
+                _generation.store(mGeneration, std::memory_order_release);
+                const uint8_t mHeadSegments = number_of_head_segments();
+                for (uint8_t i = 0; i < mHeadSegments; i++) {
+                    copy_head_segment(i, mGeneration);
+                }
+            } else {
+                _stream_data_provider->seek(0);
+                _stream_data_provider->fill_buffer(_buffer, _buffer_length);
+            }
+        }
+
+        /**
+         * @return false if the segment at the current position is not refilled yet ( asynchronous mode only, e.g right
+         * after `reset()` )
+         */
+        bool is_ready() const {
+            return !_asynchronous || is_segment_ready(segment_of(static_cast<int32_t>(_buffer_index)));
+        }
+
+        bool is_asynchronous() const {
+            return _asynchronous;
+        }
+
+        /**
+         * refills all segments requested by the audio thread. only used in asynchronous mode where it must be called
+         * from a single worker thread ( e.g by `StreamRefillWorker` ).
+         *
+         * @return true if any segment was refilled
+         */
+        bool service() {
+            if (!_asynchronous) {
+                return false;
+            }
+            bool          mDidWork = service_reset();
+            RefillRequest mRequest;
+            while (_refill_requests->pop(mRequest)) {
+                if (mRequest.generation != _serviced_generation) {
+                    /* the request may belong to a reset that was posted after `service_reset()` checked */
+                    mDidWork |= service_reset();
+                    if (mRequest.generation != _serviced_generation) {
+                        continue; /* request of a previous generation */
+                    }
+                }
+                if (!claim_segment(mRequest.segment, mRequest.generation)) {
+                    continue; /* the stream was reset in the meantime */
+                }
+                replace_segment(_buffer_division, mRequest.segment);
+                _segment_generation[mRequest.segment].store(mRequest.generation, std::memory_order_release);
+                mDidWork = true;
+            }
+            return mDidWork;
+        }
+
+        /**
+         * @return number of output samples that were replaced by silence because their segment was not refilled in time
+         */
+        uint32_t get_underruns() const {
+            return _underruns.load(std::memory_order_relaxed);
+        }
+
         float* get_buffer() const {
             return _buffer;
         }
@@ -158,18 +297,39 @@ namespace klangwellen {
     private:
         static constexpr int8_t NO_EVENT = -1;
 
-        StreamDataProvider* _stream_data_provider;
-        uint32_t            _buffer_length;
-        float*              _buffer;
-        const uint8_t       _buffer_division;
-        const uint8_t       _buffer_segment_offset;
-        float               _sample_rate;
-        float               _amplitude;
-        float               _step_size;
-        bool                _interpolate_samples;
-        float               _buffer_index;
-        float               _buffer_index_prev;
-        int8_t              _complete_event;
+        StreamDataProvider*      _stream_data_provider;
+        uint32_t                 _buffer_length;
+        float*                   _buffer;
+        const uint8_t            _buffer_division;
+        const uint8_t            _buffer_segment_offset;
+        float                    _sample_rate;
+        float                    _amplitude;
+        float                    _step_size;
+        bool                     _interpolate_samples;
+        float                    _buffer_index;
+        float                    _buffer_index_prev;
+        int8_t                   _complete_event;
+        const bool               _asynchronous;
+        const uint32_t           _segment_length;
+        /* asynchronous mode: a segment may be read while its generation equals the generation of the stream. the
+         * audio thread invalidates a segment before it requests a refill, the worker thread tags it once refilled.
+         * whichever thread writes a segment marks it as busy first, so the audio thread never copies the head into a
+         * segment the worker thread is refilling. */
+        struct RefillRequest {
+            uint32_t generation = 0;
+            uint8_t  segment    = 0;
+        };
+        static constexpr uint32_t NO_GENERATION            = 0xFFFFFFFF;
+        static constexpr uint32_t BUSY_GENERATION          = 0xFFFFFFFE;
+        static constexpr uint32_t REFILL_QUEUE_GENERATIONS = 4; /* requests of previous generations may still be queued */
+        std::atomic<uint32_t>*         _segment_generation;
+        uint32_t*                      _requested_generation; /* owned by the audio thread */
+        bool*                          _unqueued_requests;    /* owned by the audio thread */
+        bool                           _has_unqueued_requests;
+        SPSCRingBuffer<RefillRequest>* _refill_requests;
+        std::atomic<uint32_t>          _generation;
+        uint32_t                       _serviced_generation; /* owned by the worker thread */
+        std::atomic<uint32_t>          _underruns;
 
         int32_t wrapIndex(int32_t i) const {
             if (i < 0) {
@@ -184,6 +344,128 @@ namespace klangwellen {
             return pRawSample;
         }
 
+        uint8_t segment_of(const int32_t index) const {
+            return static_cast<uint8_t>(std::min(static_cast<uint32_t>(index) / _segment_length, _buffer_division - 1u));
+        }
+
+        bool is_segment_ready(const uint8_t segment_index) const {
+            return _segment_generation[segment_index].load(std::memory_order_acquire) == _generation.load(std::memory_order_relaxed);
+        }
+
+        float read_sample(const int32_t index, bool& missing) const {
+            if (_asynchronous && !is_segment_ready(segment_of(index))) {
+                missing = true;
+                return 0.0f;
+            }
+            return convert_sample(_buffer[index]);
+        }
+
+        void request_segment(const uint8_t segment_index) {
+            const uint32_t mGeneration = _generation.load(std::memory_order_relaxed);
+            /* a segment that is still pending is refilled anyway, requesting it again would overflow the queue */
+            if (_requested_generation[segment_index] == mGeneration && !is_segment_ready(segment_index)) {
+                return;
+            }
+            uint32_t mTag = _segment_generation[segment_index].load(std::memory_order_relaxed);
+            if (mTag != BUSY_GENERATION) {
+                /* fails if the worker thread started to refill the segment */
+                _segment_generation[segment_index].compare_exchange_strong(mTag, NO_GENERATION, std::memory_order_release, std::memory_order_relaxed);
+            }
+            _requested_generation[segment_index] = mGeneration;
+            queue_request(segment_index, mGeneration);
+        }
+
+        /* a request that does not fit into the queue is retried on the next call of `process()` */
+        void queue_request(const uint8_t segment_index, const uint32_t generation) {
+            RefillRequest mRequest;
+            mRequest.generation               = generation;
+            mRequest.segment                  = segment_index;
+            _unqueued_requests[segment_index] = !_refill_requests->push(mRequest);
+            _has_unqueued_requests |= _unqueued_requests[segment_index];
+        }
+
+        void queue_unqueued_requests() {
+            const uint32_t mGeneration = _generation.load(std::memory_order_relaxed);
+            _has_unqueued_requests     = false;
+            for (uint8_t i = 0; i < _buffer_division; i++) {
+                if (!_unqueued_requests[i]) {
+                    continue;
+                }
+                if (_requested_generation[i] == mGeneration) {
+                    queue_request(i, mGeneration);
+                } else {
+                    _unqueued_requests[i] = false; /* the segment is refilled by the reset */
+                }
+            }
+        }
+
+        uint8_t number_of_head_segments() const {
+            return static_cast<uint8_t>(std::min(_stream_data_provider->get_head_length() / _segment_length,
+                                                 static_cast<uint32_t>(_buffer_division)));
+        }
+
+        /* copies the head into a segment unless the worker thread is refilling it. audio thread only. */
+        void copy_head_segment(const uint8_t segment_index, const uint32_t generation) {
+            uint32_t mTag = _segment_generation[segment_index].load(std::memory_order_relaxed);
+            if (mTag == BUSY_GENERATION || mTag == generation ||
+                !_segment_generation[segment_index].compare_exchange_strong(mTag, BUSY_GENERATION, std::memory_order_acquire)) {
+                return; /* `service_reset()` refills the segment */
+            }
+            _stream_data_provider->fill_head(_buffer + segment_index * _segment_length,
+                                             segment_index * _segment_length,
+                                             _segment_length);
+            _segment_generation[segment_index].store(generation, std::memory_order_release);
+        }
+
+        /* marks a segment as busy. fails if the stream is no longer at `generation` or if `skip_ready` is set and the
+         * segment is already tagged with `generation`. worker thread only. */
+        bool claim_segment(const uint8_t segment_index, const uint32_t generation, const bool skip_ready = false) {
+            uint32_t mTag = _segment_generation[segment_index].load(std::memory_order_relaxed);
+            do {
+                while (mTag == BUSY_GENERATION) { /* the audio thread copies the head into the segment */
+                    mTag = _segment_generation[segment_index].load(std::memory_order_relaxed);
+                }
+                if (skip_ready && mTag == generation) {
+                    return false;
+                }
+            } while (!_segment_generation[segment_index].compare_exchange_weak(mTag, BUSY_GENERATION, std::memory_order_acquire));
+            if (_generation.load(std::memory_order_acquire) != generation) {
+                _segment_generation[segment_index].store(mTag, std::memory_order_release);
+                return false;
+            }
+            return true;
+        }
+
+        /* refills all segments that the audio thread did not copy from the head if the stream was reset. worker thread
+         * only. */
+        bool service_reset() {
+            const uint32_t mGeneration = _generation.load(std::memory_order_acquire);
+            if (mGeneration == _serviced_generation) {
+                return false;
+            }
+            _serviced_generation        = mGeneration;
+            const uint8_t mHeadSegments = number_of_head_segments();
+            for (uint8_t i = 0; i < mHeadSegments; i++) {
+                if (!claim_segment(i, mGeneration, true)) {
+                    if (_generation.load(std::memory_order_relaxed) != mGeneration) {
+                        return true; /* the stream was reset again */
+                    }
+                    continue; /* copied by the audio thread */
+                }
+                _stream_data_provider->fill_head(_buffer + i * _segment_length, i * _segment_length, _segment_length);
+                _segment_generation[i].store(mGeneration, std::memory_order_release);
+            }
+            _stream_data_provider->seek(mHeadSegments * _segment_length);
+            for (uint8_t i = mHeadSegments; i < _buffer_division; i++) {
+                if (!claim_segment(i, mGeneration)) {
+                    return true;
+                }
+                replace_segment(_buffer_division, i);
+                _segment_generation[i].store(mGeneration, std::memory_order_release);
+            }
+            return true;
+        }
+
         int8_t checkCompleteEvent(const uint8_t num_events) const {
             for (int i = 0; i < num_events; ++i) {
                 const float mBorder = _buffer_length * i / static_cast<float>(_buffer_division);
@@ -0,0 +1,168 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "Stream.h"
+
+#ifndef KLANGWELLEN_STREAM_REFILL_WORKER_MAX_STREAMS
+#define KLANGWELLEN_STREAM_REFILL_WORKER_MAX_STREAMS 64
+#endif
+
+namespace klangwellen {
+    /**
+     * runs a background thread that refills the segments of asynchronous `Stream`s. the audio thread posts refill
+     * requests through a wait-free queue and never waits for the worker. registering and unregistering streams takes a
+     * lock that is never taken by the audio thread and that is not held while a stream reads from its data provider (
+     * e.g from a file ).
+     * <p>
+     * a typical application could look as follows:
+     * <pre>
+     * <code>
+     *     StreamRefillWorker mWorker;
+     *     Stream             mStream(&mProvider, 48000, 4096, 4, 1, true);
+     *     mWorker.add(&mStream);
+     *     mWorker.start();
+     * </code>
+     * </pre>
+     */
+    class StreamRefillWorker {
+    public:
+        StreamRefillWorker() = default;
+
+        ~StreamRefillWorker() {
+            stop();
+        }
+
+        StreamRefillWorker(const StreamRefillWorker&)            = delete;
+        StreamRefillWorker& operator=(const StreamRefillWorker&) = delete;
+
+        void start() {
+            if (_running.exchange(true)) {
+                return;
+            }
+            _thread = std::thread(&StreamRefillWorker::run, this);
+        }
+
+        void stop() {
+            if (!_running.exchange(false)) {
+                return;
+            }
+            if (_thread.joinable()) {
+                _thread.join();
+            }
+        }
+
+        bool is_running() const {
+            return _running.load();
+        }
+
+        /**
+         * @return true if the stream was registered, false if the stream is not asynchronous or the maximum number of
+         * streams ( `KLANGWELLEN_STREAM_REFILL_WORKER_MAX_STREAMS` ) is reached
+         */
+        bool add(Stream* stream) {
+            if (stream == nullptr || !stream->is_asynchronous()) {
+                return false;
+            }
+            std::lock_guard<std::mutex> mLock(_mutex);
+            for (uint16_t i = 0; i < _number_of_streams; i++) {
+                if (_streams[i] == stream) {
+                    return true;
+                }
+            }
+            if (_number_of_streams >= KLANGWELLEN_STREAM_REFILL_WORKER_MAX_STREAMS) {
+                return false;
+            }
+            _streams[_number_of_streams++] = stream;
+            return true;
+        }
+
+        /**
+         * unregisters a stream. once this method returns the stream is no longer accessed by the worker thread. if the
+         * stream is serviced while it is removed this method waits until the refill is done.
+         */
+        void remove(Stream* stream) {
+            {
+                std::lock_guard<std::mutex> mLock(_mutex);
+                for (uint16_t i = 0; i < _number_of_streams; i++) {
+                    if (_streams[i] == stream) {
+                        _streams[i] = _streams[--_number_of_streams];
+                        break;
+                    }
+                }
+            }
+            while (_servicing.load() == stream) {
+                std::this_thread::yield();
+            }
+        }
+
+        /**
+         * services all registered streams once. can be used instead of `start()` to refill streams from an existing
+         * thread.
+         *
+         * @return true if any segment was refilled
+         */
+        bool service() {
+            bool mDidWork = false;
+            for (uint16_t i = 0;; i++) {
+                Stream* mStream = next_stream(i);
+                if (mStream == nullptr) {
+                    break;
+                }
+                mDidWork |= mStream->service();
+                _servicing.store(nullptr);
+            }
+            return mDidWork;
+        }
+
+    private:
+        Stream*              _streams[KLANGWELLEN_STREAM_REFILL_WORKER_MAX_STREAMS]{};
+        uint16_t             _number_of_streams = 0;
+        std::mutex           _mutex;
+        std::atomic<Stream*> _servicing{nullptr};
+        std::thread          _thread;
+        std::atomic<bool>    _running{false};
+
+        /* marks the stream at index as being serviced, `remove()` waits for it */
+        Stream* next_stream(const uint16_t index) {
+            std::lock_guard<std::mutex> mLock(_mutex);
+            if (index >= _number_of_streams) {
+                return nullptr;
+            }
+            _servicing.store(_streams[index]);
+            return _streams[index];
+        }
+
+        void run() {
+            while (_running.load()) {
+                if (!service()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        }
+    };
+} // namespace klangwellen
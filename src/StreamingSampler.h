@@ -0,0 +1,423 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * PROCESSOR INTERFACE
+ *
+ * - [x] float process()
+ * - [ ] float process(float)
+ * - [ ] void process(AudioSignal&)
+ * - [x] void process(float*, uint32_t)
+ * - [ ] void process(float*, float*, uint32_t)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "KlangWellen.h"
+#include "PCMConversion.h"
+#include "SampleFileFormat.h"
+#include "Stream.h"
+#include "StreamRefillWorker.h"
+
+namespace klangwellen {
+    /**
+     * provides the sample data of a WAV or AIFF file to an asynchronous `Stream`. the first `head_frames` frames ( i.e
+     * the head ) are preloaded into memory and copied by the audio thread when the stream is reset, the remainder of the
+     * file is read by the worker thread of a `StreamRefillWorker` whenever the stream requests a refill. the audio
+     * thread never touches the file.
+     * <p>
+     * file offsets are 64 bit, so files larger than 2 GB can be streamed ( on 32-bit POSIX systems this requires
+     * `_FILE_OFFSET_BITS=64` ). only the first channel of multichannel files is streamed.
+     */
+    class SampleFileStreamDataProvider final : public StreamDataProvider {
+    public:
+        static constexpr uint32_t DEFAULT_HEAD_FRAMES = 65536;
+
+        SampleFileStreamDataProvider() = default;
+
+        ~SampleFileStreamDataProvider() override {
+            close();
+        }
+
+        SampleFileStreamDataProvider(const SampleFileStreamDataProvider&)            = delete;
+        SampleFileStreamDataProvider& operator=(const SampleFileStreamDataProvider&) = delete;
+
+        /**
+         * opens a file, parses its header and preloads the head. must not be called while the stream of the provider is
+         * registered with a `StreamRefillWorker`.
+         *
+         * @param filepath    path to a WAV or AIFF file
+         * @param head_frames number of frames preloaded into memory. restarting the stream only reads from the head as
+         *                    long as it covers the stream buffer.
+         * @return true if the file was opened and contains a readable sample format
+         */
+        bool open(const char* filepath, const uint32_t head_frames = DEFAULT_HEAD_FRAMES) {
+            close();
+            _file = fopen(filepath, "rb");
+            if (_file == nullptr) {
+                return false;
+            }
+            if (!read_header()) {
+                close();
+                return false;
+            }
+            _scratch_buffer = new uint8_t[READ_CHUNK_FRAMES * get_bytes_per_frame()];
+            _head_length    = std::min(head_frames, _file_format.get_number_of_frames());
+            _head           = new float[_head_length > 0 ? _head_length : 1];
+            _file_frame     = NO_FRAME;
+            _read_frame     = 0;
+            if (read_file(_head, _head_length) != _head_length) {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        void close() {
+            if (_file != nullptr) {
+                fclose(_file);
+                _file = nullptr;
+            }
+            delete[] _head;
+            delete[] _scratch_buffer;
+            _head           = nullptr;
+            _scratch_buffer = nullptr;
+            _head_length    = 0;
+            _file_format.clear();
+        }
+
+        bool is_open() const {
+            return _file != nullptr;
+        }
+
+        uint32_t get_sample_rate() const {
+            return _file_format.get_sample_rate();
+        }
+
+        uint32_t get_number_of_frames() const {
+            return _file_format.get_number_of_frames();
+        }
+
+        /**
+         * restarts the data at `frame`. called by `Stream::reset()` ( i.e from the worker thread ).
+         */
+        void seek(const uint32_t frame) override {
+            _read_frame = frame;
+        }
+
+        uint32_t get_head_length() const override {
+            return _head_length;
+        }
+
+        /**
+         * called from the audio thread ( via `Stream::reset()` ).
+         */
+        void fill_head(float* buffer, const uint32_t offset, const uint32_t length) const override {
+            std::copy_n(_head + offset, length, buffer);
+        }
+
+        /**
+         * called from the worker thread ( via `Stream::service()` ). frames after the end of the file are silent.
+         */
+        void fill_buffer(float* buffer, const uint32_t length) override {
+            if (!is_open()) {
+                std::fill_n(buffer, length, 0.0f);
+                return;
+            }
+            uint32_t i = 0;
+            if (_read_frame < _head_length) {
+                const uint32_t mLength = std::min(length, _head_length - _read_frame);
+                std::copy_n(_head + _read_frame, mLength, buffer);
+                _read_frame += mLength;
+                i += mLength;
+            }
+            const uint32_t mNumberOfFrames = _file_format.get_number_of_frames();
+            if (i < length && _read_frame < mNumberOfFrames) {
+                const uint32_t mLength = read_file(buffer + i, std::min(length - i, mNumberOfFrames - _read_frame));
+                _read_frame += mLength;
+                i += mLength;
+            }
+            if (i < length) {
+                std::fill_n(buffer + i, length - i, 0.0f);
+            }
+        }
+
+    private:
+        static constexpr uint32_t READ_CHUNK_FRAMES = 4096;
+        static constexpr uint32_t HEADER_SIZE       = 65536;
+        static constexpr uint32_t NO_FRAME          = 0xFFFFFFFF;
+
+        FILE*            _file           = nullptr;
+        SampleFileFormat _file_format;
+        float*           _head           = nullptr;
+        uint32_t         _head_length    = 0;
+        uint8_t*         _scratch_buffer = nullptr;
+        /* next frame delivered to the stream */
+        uint32_t _read_frame = 0;
+        /* frame at the current file position or `NO_FRAME` if the file position is not in the sample data */
+        uint32_t _file_frame = 0;
+
+        uint32_t get_bytes_per_frame() const {
+            return _file_format.get_bytes_per_sample() * _file_format.get_number_of_channels();
+        }
+
+        static bool seek_file(FILE* file, const uint64_t offset, const int origin) {
+#if defined(_WIN32)
+            return _fseeki64(file, static_cast<__int64>(offset), origin) == 0;
+#else
+            return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+        }
+
+        static int64_t tell_file(FILE* file) {
+#if defined(_WIN32)
+            return _ftelli64(file);
+#else
+            return ftello(file);
+#endif
+        }
+
+        bool read_header() {
+            if (!seek_file(_file, 0, SEEK_END)) {
+                return false;
+            }
+            const int64_t mFileLength = tell_file(_file);
+            if (mFileLength <= 0 || !seek_file(_file, 0, SEEK_SET)) {
+                return false;
+            }
+            const size_t mHeaderLength = static_cast<size_t>(std::min(mFileLength, static_cast<int64_t>(HEADER_SIZE)));
+            uint8_t*     mHeader       = new uint8_t[mHeaderLength];
+            const bool   mParsed       = fread(mHeader, 1, mHeaderLength, _file) == mHeaderLength &&
+                                 _file_format.parse(mHeader, mHeaderLength, static_cast<size_t>(mFileLength));
+            delete[] mHeader;
+            return mParsed;
+        }
+
+        /* reads frames at `_read_frame` from the file and converts the first channel to float */
+        uint32_t read_file(float* buffer, const uint32_t number_of_frames) {
+            const uint32_t mBytesPerFrame = get_bytes_per_frame();
+            if (_file_frame != _read_frame) {
+                const uint64_t mOffset = static_cast<uint64_t>(_file_format.get_data_offset()) + static_cast<uint64_t>(_read_frame) * mBytesPerFrame;
+                if (!seek_file(_file, mOffset, SEEK_SET)) {
+                    _file_frame = NO_FRAME;
+                    return 0;
+                }
+                _file_frame = _read_frame;
+            }
+            uint32_t mFramesRead = 0;
+            while (mFramesRead < number_of_frames) {
+                const uint32_t mLength = std::min(number_of_frames - mFramesRead, READ_CHUNK_FRAMES);
+                const uint32_t mRead   = static_cast<uint32_t>(fread(_scratch_buffer, mBytesPerFrame, mLength, _file));
+                float*         mBuffer = buffer + mFramesRead;
+                if (_file_format.get_format() == SampleFileFormat::FORMAT_FLOAT32) {
+                    for (uint32_t i = 0; i < mRead; i++) {
+                        memcpy(mBuffer + i, _scratch_buffer + i * mBytesPerFrame, sizeof(float));
+                    }
+                } else {
+                    PCMConversion::decode(_scratch_buffer, mBuffer, mRead, _file_format.get_format(), _file_format.get_number_of_channels());
+                }
+                mFramesRead += mRead;
+                _file_frame += mRead;
+                if (mRead < mLength) {
+                    break;
+                }
+            }
+            return mFramesRead;
+        }
+    };
+
+    /**
+     * plays a WAV or AIFF file from disk. only the head of the file is kept in memory, the remainder is streamed by
+     * the worker thread of a `StreamRefillWorker`. this allows to play sample sets that are much larger than the
+     * available memory. notes are played relative to the root note ( i.e the note at which the file is played at its
+     * original speed ).
+     * <p>
+     * a typical application could look as follows:
+     * <pre>
+     * <code>
+     *     StreamRefillWorker mWorker;
+     *     StreamingSampler   mSampler(mWorker, 48000);
+     *     mSampler.open("piano_C4.wav");
+     *     mWorker.start();
+     *     mSampler.note_on(Note::E_4, 100);
+     * </code>
+     * </pre>
+     * the head of the file always covers the stream buffer, so notes start without waiting for the worker thread. samples
+     * that are not refilled in time during playback are replaced with silence and counted as underruns.
+     */
+    class StreamingSampler {
+    public:
+        static constexpr uint32_t DEFAULT_STREAM_BUFFER_SIZE = 4096;
+        static constexpr uint8_t  DEFAULT_ROOT_NOTE          = 60;
+
+        StreamingSampler(StreamRefillWorker& worker,
+                         const uint32_t      sample_rate,
+                         const uint32_t      stream_buffer_size = DEFAULT_STREAM_BUFFER_SIZE)
+            : _worker(worker),
+              _stream(&_provider, sample_rate, stream_buffer_size, STREAM_BUFFER_DIVISION, 1, true),
+              _sample_rate(sample_rate),
+              _root_frequency(KlangWellen::midi_note_to_frequency(DEFAULT_ROOT_NOTE)) {}
+
+        ~StreamingSampler() {
+            close();
+        }
+
+        StreamingSampler(const StreamingSampler&)            = delete;
+        StreamingSampler& operator=(const StreamingSampler&) = delete;
+
+        /**
+         * opens a file and registers its stream with the worker. must not be called while the sampler is processed.
+         *
+         * @param filepath    path to a WAV or AIFF file
+         * @param head_frames number of frames kept in memory ( at least the length of the stream buffer )
+         */
+        bool open(const char* filepath, const uint32_t head_frames = SampleFileStreamDataProvider::DEFAULT_HEAD_FRAMES) {
+            close();
+            if (!_provider.open(filepath, std::max(head_frames, _stream.get_buffer_length()))) {
+                return false;
+            }
+            update_speed();
+            return _worker.add(&_stream);
+        }
+
+        void close() {
+            _is_playing = false;
+            _worker.remove(&_stream);
+            _provider.close();
+        }
+
+        bool is_open() const {
+            return _provider.is_open();
+        }
+
+        void play() {
+            if (!_provider.is_open()) {
+                return;
+            }
+            _stream.reset();
+            _position   = 0.0;
+            _is_playing = true;
+        }
+
+        void stop() {
+            _is_playing = false;
+        }
+
+        bool is_playing() const {
+            return _is_playing;
+        }
+
+        /**
+         * @param root_note MIDI note at which the file is played at its original speed ( default: `60` )
+         */
+        void set_root_note(const uint8_t root_note) {
+            _root_frequency = KlangWellen::midi_note_to_frequency(root_note);
+        }
+
+        /**
+         * plays the file pitched relative to the root note with the velocity as amplitude.
+         */
+        void note_on(const uint8_t note, const uint8_t velocity) {
+            _pitch = KlangWellen::midi_note_to_frequency(note) / _root_frequency;
+            update_speed();
+            set_amplitude(KlangWellen::clamp127(velocity) / 127.0f);
+            play();
+        }
+
+        void note_off() {
+            stop();
+        }
+
+        float get_amplitude() const {
+            return _amplitude;
+        }
+
+        void set_amplitude(const float amplitude) {
+            _amplitude = amplitude;
+        }
+
+        float get_speed() const {
+            return _speed;
+        }
+
+        /**
+         * @param speed playback speed where 1.0 plays the file at its original pitch ( or at the pitch of the last note )
+         */
+        void set_speed(const float speed) {
+            _speed = speed;
+            update_speed();
+        }
+
+        void interpolate_samples(const bool interpolate_samples) {
+            _stream.interpolate_samples(interpolate_samples);
+        }
+
+        /**
+         * @return number of samples that were replaced by silence because the worker thread did not refill the stream in
+         * time
+         */
+        uint32_t get_underruns() const {
+            return _stream.get_underruns();
+        }
+
+        float process() {
+            if (!_is_playing || !_stream.is_ready()) {
+                return 0.0f;
+            }
+            const float mSample = _stream.process() * _amplitude;
+            _position += _stream.get_speed();
+            if (_position >= _provider.get_number_of_frames()) {
+                _is_playing = false;
+            }
+            return mSample;
+        }
+
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            for (uint32_t i = 0; i < buffer_length; i++) {
+                signal_buffer[i] = process();
+            }
+        }
+
+    private:
+        static constexpr uint8_t STREAM_BUFFER_DIVISION = 4;
+
+        StreamRefillWorker&          _worker;
+        SampleFileStreamDataProvider _provider;
+        Stream                       _stream;
+        const uint32_t               _sample_rate;
+        float                        _root_frequency;
+        float                        _pitch      = 1.0f;
+        float                        _amplitude  = 1.0f;
+        float                        _speed      = 1.0f;
+        double                       _position   = 0.0; /* a float stops advancing after 2^24 frames */
+        bool                         _is_playing = false;
+
+        void update_speed() {
+            const uint32_t mFileSampleRate = _provider.get_sample_rate();
+            const float    mSpeed          = _speed * _pitch;
+            _stream.set_speed(mFileSampleRate > 0 ? mSpeed * mFileSampleRate / _sample_rate : mSpeed);
+        }
+    };
+} // namespace klangwellen
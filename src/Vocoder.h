@@ -238,7 +238,7 @@ namespace klangwellen {
          * The function will only fail if the parameter is invalid.
          */
         uint8_t set_formant_shift(const float pFormant_shift) {
-            if (_formant_shift < 0.25f || _formant_shift > 4.0f) {
+            if (pFormant_shift < 0.25f || pFormant_shift > 4.0f) {
                 return 0;
             }
 
@@ -274,7 +274,7 @@ namespace klangwellen {
          * The function will only fail if the parameter is invalid.
          */
         uint8_t set_reaction_time(const float pReaction_time) {
-            if (_reaction_time < 0.002f || _reaction_time > 2.0f) {
+            if (pReaction_time < 0.002f || pReaction_time > 2.0f) {
                 return 0;
             }
 
@@ -306,6 +306,12 @@ namespace klangwellen {
          * The maximum number of filters per vocoder band (lower this number to save memory).
          */
         static constexpr uint8_t VOCLIB_MAX_FILTERS_PER_BAND = 8;
+        /**
+         * The maximum number of bands that the vocoder can be initialized with (lower this number to save memory).
+         */
+        static constexpr uint8_t VOCLIB_MAX_BANDS = 96;
+        /* coefficients of a biquad ( a0 - a4 ) */
+        static constexpr uint8_t NUMBER_OF_COEFFICIENTS = 5;
 
     public:
         /**
@@ -337,6 +343,52 @@ namespace klangwellen {
             // }
         };
 
+        /**
+         * coefficients of the synthesis filterbank for a formant shift ( i.e the 5 coefficients of the band pass filter
+         * of each band ). the struct is about 2 KB, a `ParameterQueue` that passes it should have a small capacity (
+         * e.g `ParameterQueue<Vocoder, Vocoder::FormantCoefficients> mQueue(2)` ).
+         */
+        struct FormantCoefficients {
+            float formant_shift = 1.0f;
+            float filters[VOCLIB_MAX_BANDS][NUMBER_OF_COEFFICIENTS]{};
+        };
+
+        /**
+         * computes the synthesis filterbank for a formant shift without changing the vocoder. computing the filterbank
+         * is expensive, this function may run on a control thread while the audio thread keeps processing. the
+         * coefficients are then applied with `set_formant_coefficients()` ( e.g via a `ParameterQueue` ).
+         *
+         * @return false if the formant shift is not between 0.25 and 4.0 (inclusive)
+         */
+        bool compute_formant_coefficients(const float pFormant_shift, FormantCoefficients& pCoefficients) const {
+            if (pFormant_shift < 0.25f || pFormant_shift > 4.0f) {
+                return false;
+            }
+            pCoefficients.formant_shift = pFormant_shift;
+            for_each_band([&](const uint8_t i, const float frequency, const float bandwidth) {
+                biquad mFilter;
+                BiQuad_new(mFilter,
+                           VOCLIB_BPF,
+                           0.0f,
+                           frequency * pFormant_shift,
+                           static_cast<float>(_samplerate),
+                           bandwidth);
+                copy_coefficients(pCoefficients.filters[i], mFilter);
+            });
+            return true;
+        }
+
+        /**
+         * sets the formant shift from coefficients computed with `compute_formant_coefficients()`. only copies the
+         * coefficients and is cheap enough to be called from the audio thread.
+         */
+        void set_formant_coefficients(const FormantCoefficients& pCoefficients) {
+            _formant_shift = pCoefficients.formant_shift;
+            for (uint8_t i = 0; i < _bands; ++i) {
+                set_synthesis_band(i, pCoefficients.filters[i]);
+            }
+        }
+
     private:
         /* filter types. */
         static constexpr uint8_t VOCLIB_LPF       = 0;                      /* low pass filter */
@@ -346,7 +398,6 @@ namespace klangwellen {
         static constexpr uint8_t VOCLIB_PEQ       = 4;                      /* Peaking band EQ filter */
         static constexpr uint8_t VOCLIB_LSH       = 5;                      /* Low shelf filter */
         static constexpr uint8_t VOCLIB_HSH       = 6;                      /* High shelf filter */
-        static constexpr uint8_t VOCLIB_MAX_BANDS = 96;                     /* The maximum number of bands that the vocoder can be initialized with (lower this number to save memory). */
         static constexpr float   VOCLIB_M_LN2     = 0.69314718055994530942; /**/
         static constexpr float   VOCLIB_M_PI      = 3.14159265358979323846; /**/
         const uint32_t           _samplerate;                               /* in Hz */
@@ -522,19 +573,19 @@ namespace klangwellen {
             }
         }
 
-        /* Initialize the vocoder filterbank. */
-        void initialize_filterbank(const bool pCarrier_only) {
-            uint8_t i;
-            float   step;
-            float   lastfreq = 0.0;
-            float   minfreq  = 80.0;
-            float   maxfreq  = _samplerate;
+        /* Calls `function(band, frequency, bandwidth)` for every band of the filterbank. */
+        template<typename FUNCTION>
+        void for_each_band(FUNCTION&& function) const {
+            float step;
+            float lastfreq = 0.0;
+            float minfreq  = 80.0;
+            float maxfreq  = _samplerate;
             if (maxfreq > 12000.0) {
                 maxfreq = 12000.0;
             }
             step = KlangWellen::pow((maxfreq / minfreq), (1.0 / _bands));
 
-            for (i = 0; i < _bands; ++i) {
+            for (uint8_t i = 0; i < _bands; ++i) {
                 float bandwidth, nextfreq;
                 float priorfreq = lastfreq;
                 if (lastfreq > 0.0) {
@@ -544,58 +595,66 @@ namespace klangwellen {
                 }
                 nextfreq  = lastfreq * step;
                 bandwidth = (nextfreq - priorfreq) / lastfreq;
+                function(i, lastfreq, bandwidth);
+            }
+        }
+
+        static void copy_coefficients(biquad& pTarget, const biquad& pSource) {
+            pTarget.a0 = pSource.a0;
+            pTarget.a1 = pSource.a1;
+            pTarget.a2 = pSource.a2;
+            pTarget.a3 = pSource.a3;
+            pTarget.a4 = pSource.a4;
+        }
+
+        static void copy_coefficients(biquad& pTarget, const float (&pSource)[NUMBER_OF_COEFFICIENTS]) {
+            pTarget.a0 = pSource[0];
+            pTarget.a1 = pSource[1];
+            pTarget.a2 = pSource[2];
+            pTarget.a3 = pSource[3];
+            pTarget.a4 = pSource[4];
+        }
+
+        static void copy_coefficients(float (&pTarget)[NUMBER_OF_COEFFICIENTS], const biquad& pSource) {
+            pTarget[0] = pSource.a0;
+            pTarget[1] = pSource.a1;
+            pTarget[2] = pSource.a2;
+            pTarget[3] = pSource.a3;
+            pTarget[4] = pSource.a4;
+        }
+
+        /* Copies the coefficients of one filter to all filters of a synthesis band ( both channels ). */
+        template<typename COEFFICIENTS>
+        void set_synthesis_band(const uint8_t pBand, const COEFFICIENTS& pCoefficients) {
+            for (uint8_t j = 0; j < _filters_per_band; ++j) {
+                copy_coefficients(_synthesis_bands[pBand].filters[j], pCoefficients);
+                copy_coefficients(_synthesis_bands[pBand + VOCLIB_MAX_BANDS].filters[j], pCoefficients);
+            }
+        }
 
+        /* Initialize the vocoder filterbank. */
+        void initialize_filterbank(const bool pCarrier_only) {
+            for_each_band([&](const uint8_t i, const float frequency, const float bandwidth) {
                 if (!pCarrier_only) {
                     BiQuad_new(_analysis_bands[i].filters[0],
                                VOCLIB_BPF,
                                0.0f,
-                               lastfreq,
+                               frequency,
                                _samplerate,
                                bandwidth);
                     for (uint8_t j = 1; j < _filters_per_band; ++j) {
-                        _analysis_bands[i].filters[j].a0 = _analysis_bands[i].filters[0].a0;
-                        _analysis_bands[i].filters[j].a1 = _analysis_bands[i].filters[0].a1;
-                        _analysis_bands[i].filters[j].a2 = _analysis_bands[i].filters[0].a2;
-                        _analysis_bands[i].filters[j].a3 = _analysis_bands[i].filters[0].a3;
-                        _analysis_bands[i].filters[j].a4 = _analysis_bands[i].filters[0].a4;
+                        copy_coefficients(_analysis_bands[i].filters[j], _analysis_bands[i].filters[0]);
                     }
                 }
-
-                if (_formant_shift != 1.0f) {
-                    BiQuad_new(_synthesis_bands[i].filters[0],
-                               VOCLIB_BPF,
-                               0.0f,
-                               lastfreq * _formant_shift,
-                               static_cast<float>(_samplerate),
-                               bandwidth);
-                } else {
-                    _synthesis_bands[i].filters[0].a0 = _analysis_bands[i].filters[0].a0;
-                    _synthesis_bands[i].filters[0].a1 = _analysis_bands[i].filters[0].a1;
-                    _synthesis_bands[i].filters[0].a2 = _analysis_bands[i].filters[0].a2;
-                    _synthesis_bands[i].filters[0].a3 = _analysis_bands[i].filters[0].a3;
-                    _synthesis_bands[i].filters[0].a4 = _analysis_bands[i].filters[0].a4;
-                }
-
-                _synthesis_bands[i + VOCLIB_MAX_BANDS].filters[0].a0 = _synthesis_bands[i].filters[0].a0;
-                _synthesis_bands[i + VOCLIB_MAX_BANDS].filters[0].a1 = _synthesis_bands[i].filters[0].a1;
-                _synthesis_bands[i + VOCLIB_MAX_BANDS].filters[0].a2 = _synthesis_bands[i].filters[0].a2;
-                _synthesis_bands[i + VOCLIB_MAX_BANDS].filters[0].a3 = _synthesis_bands[i].filters[0].a3;
-                _synthesis_bands[i + VOCLIB_MAX_BANDS].filters[0].a4 = _synthesis_bands[i].filters[0].a4;
-
-                for (uint8_t j = 1; j < _filters_per_band; ++j) {
-                    _synthesis_bands[i].filters[j].a0 = _synthesis_bands[i].filters[0].a0;
-                    _synthesis_bands[i].filters[j].a1 = _synthesis_bands[i].filters[0].a1;
-                    _synthesis_bands[i].filters[j].a2 = _synthesis_bands[i].filters[0].a2;
-                    _synthesis_bands[i].filters[j].a3 = _synthesis_bands[i].filters[0].a3;
-                    _synthesis_bands[i].filters[j].a4 = _synthesis_bands[i].filters[0].a4;
-
-                    _synthesis_bands[i + VOCLIB_MAX_BANDS].filters[j].a0 = _synthesis_bands[i].filters[0].a0;
-                    _synthesis_bands[i + VOCLIB_MAX_BANDS].filters[j].a1 = _synthesis_bands[i].filters[0].a1;
-                    _synthesis_bands[i + VOCLIB_MAX_BANDS].filters[j].a2 = _synthesis_bands[i].filters[0].a2;
-                    _synthesis_bands[i + VOCLIB_MAX_BANDS].filters[j].a3 = _synthesis_bands[i].filters[0].a3;
-                    _synthesis_bands[i + VOCLIB_MAX_BANDS].filters[j].a4 = _synthesis_bands[i].filters[0].a4;
-                }
-            }
+                biquad mSynthesisFilter;
+                BiQuad_new(mSynthesisFilter,
+                           VOCLIB_BPF,
+                           0.0f,
+                           frequency * _formant_shift,
+                           static_cast<float>(_samplerate),
+                           bandwidth);
+                set_synthesis_band(i, mSynthesisFilter);
+            });
         }
 
         /* REVISION HISTORY
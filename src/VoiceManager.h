@@ -0,0 +1,256 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * PROCESSOR INTERFACE
+ *
+ * - [x] float process()
+ * - [ ] float process(float)
+ * - [ ] void process(AudioSignal&)
+ * - [x] void process(float*, uint32_t) *overwrite*
+ * - [ ] void process(float*, float*, uint32_t)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#include "KlangWellen.h"
+#include "Note.h"
+
+namespace klangwellen {
+    /**
+     * plays MIDI notes on a fixed number of preallocated voices ( e.g `WavetableVoice` ). all voices are constructed with
+     * the arguments passed to the voice manager, no memory is allocated after construction:
+     * <pre>
+     * <code>
+     *     VoiceManager<WavetableVoice, 8> mVoices(mWavetable, 512, 48000);
+     *     mVoices.note_on(Note::A_4, 100);
+     *     mVoices.process(mBuffer, 128);
+     *     mVoices.note_off(Note::A_4);
+     * </code>
+     * </pre>
+     * a note is played on the voice that already plays it, on an idle voice or, if all voices are busy, on a stolen voice.
+     * released voices are stolen before voices with held notes, among those the voice is chosen according to the voice
+     * stealing strategy ( i.e `KlangWellen::VOICE_STEALING_OLDEST` or `KlangWellen::VOICE_STEALING_QUIETEST` ). released voices keep playing until they are idle ( e.g until the release
+     * stage of their envelope has ended ). only voices that are not idle are processed.
+     * <p>
+     * a voice must implement the following methods:
+     * <pre>
+     * <code>
+     *     void  note_on(uint8_t note, uint8_t velocity);
+     *     void  note_off();
+     *     bool  is_idle() const;
+     *     float get_amplitude() const;
+     *     void  process(float* signal_buffer, uint32_t buffer_length); // overwrites the buffer
+     * </code>
+     * </pre>
+     */
+    template<class VOICE, uint8_t NUMBER_OF_VOICES>
+    class VoiceManager {
+    public:
+        static_assert(NUMBER_OF_VOICES > 0 && NUMBER_OF_VOICES <= 127, "number of voices must be between 1 and 127");
+
+        /**
+         * @param voice_arguments arguments passed to the constructor of each voice
+         */
+        template<typename... ARGUMENTS,
+                 typename = std::enable_if_t<!(sizeof...(ARGUMENTS) == 1 && (std::is_same_v<std::decay_t<ARGUMENTS>, VoiceManager> && ...))>>
+        explicit VoiceManager(ARGUMENTS&&... voice_arguments) : VoiceManager(std::make_index_sequence<NUMBER_OF_VOICES>{}, voice_arguments...) {}
+
+        VoiceManager(const VoiceManager&)            = delete;
+        VoiceManager& operator=(const VoiceManager&) = delete;
+
+        /**
+         * @param voice_stealing either `KlangWellen::VOICE_STEALING_OLDEST` or `KlangWellen::VOICE_STEALING_QUIETEST`
+         */
+        void set_voice_stealing(const uint8_t voice_stealing) {
+            _voice_stealing = voice_stealing;
+        }
+
+        uint8_t get_voice_stealing() const {
+            return _voice_stealing;
+        }
+
+        /**
+         * plays a note. if the note is already playing its voice is retriggered, otherwise an idle voice is used or, if all
+         * voices are busy, a voice is stolen.
+         *
+         * @return index of the voice playing the note
+         */
+        int8_t note_on(const uint8_t note, const uint8_t velocity) {
+            const uint8_t mIndex = find_voice(note);
+            VoiceState&   mState = _states[mIndex];
+            mState.note          = note;
+            mState.age           = _voice_counter++;
+            mState.is_note_held  = true;
+            _voices[mIndex].note_on(note, velocity);
+            return static_cast<int8_t>(mIndex);
+        }
+
+        /**
+         * releases the voice playing the note.
+         */
+        void note_off(const uint8_t note) {
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                if (_states[i].is_note_held && _states[i].note == note) {
+                    _states[i].is_note_held = false;
+                    _voices[i].note_off();
+                }
+            }
+        }
+
+        /**
+         * releases all voices.
+         */
+        void note_off() {
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                if (_states[i].is_note_held) {
+                    _states[i].is_note_held = false;
+                    _voices[i].note_off();
+                }
+            }
+        }
+
+        /**
+         * @return voice at index. can be used to change the parameters of a voice ( e.g the filter of a `WavetableVoice` )
+         */
+        VOICE& get_voice(const uint8_t voice) {
+            return _voices[std::min(voice, static_cast<uint8_t>(NUMBER_OF_VOICES - 1))];
+        }
+
+        /**
+         * calls `function(voice)` for all voices e.g to change a parameter of all voices.
+         */
+        template<typename FUNCTION>
+        void for_each_voice(FUNCTION&& function) {
+            for (VOICE& mVoice: _voices) {
+                function(mVoice);
+            }
+        }
+
+        bool is_voice_active(const uint8_t voice) const {
+            return voice < NUMBER_OF_VOICES && !_voices[voice].is_idle();
+        }
+
+        uint8_t get_number_of_active_voices() const {
+            uint8_t mActiveVoices = 0;
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                mActiveVoices += _voices[i].is_idle() ? 0 : 1;
+            }
+            return mActiveVoices;
+        }
+
+        static constexpr uint8_t get_number_of_voices() {
+            return NUMBER_OF_VOICES;
+        }
+
+        float process() {
+            float mSample;
+            process(&mSample, 1);
+            return mSample;
+        }
+
+        /**
+         * renders and mixes all active voices into the signal buffer. idle voices cost nothing.
+         */
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            std::fill_n(signal_buffer, buffer_length, 0.0f);
+            float mVoiceBuffer[RENDER_CHUNK_SIZE];
+            for (uint8_t v = 0; v < NUMBER_OF_VOICES; v++) {
+                VOICE& mVoice = _voices[v];
+                if (mVoice.is_idle()) {
+                    continue;
+                }
+                for (uint32_t i = 0; i < buffer_length; i += RENDER_CHUNK_SIZE) {
+                    const uint32_t mLength = std::min(RENDER_CHUNK_SIZE, buffer_length - i);
+                    mVoice.process(mVoiceBuffer, mLength);
+                    for (uint32_t j = 0; j < mLength; j++) {
+                        signal_buffer[i + j] += mVoiceBuffer[j];
+                    }
+                }
+            }
+        }
+
+    private:
+        static constexpr uint32_t RENDER_CHUNK_SIZE = 64;
+
+        struct VoiceState {
+            uint32_t age          = 0;
+            uint8_t  note         = 0;
+            bool     is_note_held = false;
+        };
+
+        std::array<VOICE, NUMBER_OF_VOICES> _voices;
+        VoiceState                          _states[NUMBER_OF_VOICES];
+        uint8_t                             _voice_stealing = KlangWellen::VOICE_STEALING_OLDEST;
+        uint32_t                            _voice_counter  = 0;
+
+        template<size_t... INDICES, typename... ARGUMENTS>
+        VoiceManager(std::index_sequence<INDICES...>, ARGUMENTS&... voice_arguments) : _voices{{((void) INDICES, VOICE(voice_arguments...))...}} {}
+
+        uint8_t find_voice(const uint8_t note) const {
+            /* retrigger voice already playing the note */
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                if (!_voices[i].is_idle() && _states[i].note == note) {
+                    return i;
+                }
+            }
+            /* use idle voice */
+            for (uint8_t i = 0; i < NUMBER_OF_VOICES; i++) {
+                if (_voices[i].is_idle()) {
+                    return i;
+                }
+            }
+            /* steal voice */
+            uint8_t mStolenVoice = 0;
+            for (uint8_t i = 1; i < NUMBER_OF_VOICES; i++) {
+                if (is_better_to_steal(i, mStolenVoice)) {
+                    mStolenVoice = i;
+                }
+            }
+            return mStolenVoice;
+        }
+
+        /* released voices are stolen first, then the quietest or oldest voice */
+        bool is_better_to_steal(const uint8_t candidate, const uint8_t voice) const {
+            if (_states[candidate].is_note_held != _states[voice].is_note_held) {
+                return !_states[candidate].is_note_held;
+            }
+            if (_voice_stealing == KlangWellen::VOICE_STEALING_QUIETEST) {
+                const float mCandidateAmplitude = _voices[candidate].get_amplitude();
+                const float mVoiceAmplitude     = _voices[voice].get_amplitude();
+                if (mCandidateAmplitude != mVoiceAmplitude) {
+                    return mCandidateAmplitude < mVoiceAmplitude;
+                }
+            }
+            return is_older(_states[candidate], _states[voice]);
+        }
+
+        bool is_older(const VoiceState& a, const VoiceState& b) const {
+            /* compare relative to counter to survive wrap around */
+            return (_voice_counter - a.age) > (_voice_counter - b.age);
+        }
+    };
+} // namespace klangwellen
@@ -31,6 +31,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 #include "KlangWellen.h"
 
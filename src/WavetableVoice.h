@@ -0,0 +1,108 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * PROCESSOR INTERFACE
+ *
+ * - [x] float process()
+ * - [ ] float process(float)
+ * - [ ] void process(AudioSignal&)
+ * - [x] void process(float*, uint32_t) *overwrite*
+ * - [ ] void process(float*, float*, uint32_t)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "ADSR.h"
+#include "Filter.h"
+#include "KlangWellen.h"
+#include "Wavetable.h"
+
+namespace klangwellen {
+    /**
+     * synthesizer voice that passes a wavetable oscillator through an envelope and a filter. the wavetable is not copied
+     * and may be shared by many voices ( e.g all voices of a `VoiceManager` ):
+     * <pre>
+     * <code>
+     *     float mWavetable[512];
+     *     Wavetable::fill(mWavetable, 512, KlangWellen::WAVEFORM_SAWTOOTH);
+     *     VoiceManager<WavetableVoice, 8> mVoices(mWavetable, 512, 48000);
+     * </code>
+     * </pre>
+     */
+    class WavetableVoice {
+    public:
+        WavetableVoice(float* wavetable, const uint32_t wavetable_size, const uint32_t sample_rate) : _oscillator(wavetable, wavetable_size, sample_rate),
+                                                                                                      _envelope(sample_rate),
+                                                                                                      _filter(sample_rate) {}
+
+        /**
+         * sets the frequency of the oscillator to the MIDI note, the velocity to its amplitude and starts the envelope.
+         */
+        void note_on(const uint8_t note, const uint8_t velocity) {
+            _oscillator.set_frequency(KlangWellen::midi_note_to_frequency(note));
+            _oscillator.set_amplitude(KlangWellen::clamp127(velocity) / 127.0f);
+            _envelope.start();
+        }
+
+        void note_off() {
+            _envelope.stop();
+        }
+
+        /**
+         * @return true if the envelope has ended and the voice is silent
+         */
+        bool is_idle() const {
+            return _envelope.is_idle();
+        }
+
+        float get_amplitude() const {
+            return _envelope.get_amplitude() * _oscillator.get_amplitude();
+        }
+
+        Wavetable& get_oscillator() {
+            return _oscillator;
+        }
+
+        ADSR& get_envelope() {
+            return _envelope;
+        }
+
+        Filter& get_filter() {
+            return _filter;
+        }
+
+        float process() {
+            return _filter.process(_envelope.process(_oscillator.process()));
+        }
+
+        void process(float* signal_buffer, const uint32_t buffer_length) {
+            _oscillator.process(signal_buffer, buffer_length);
+            _envelope.process(signal_buffer, buffer_length);
+            _filter.process(signal_buffer, buffer_length);
+        }
+
+    private:
+        Wavetable _oscillator;
+        ADSR      _envelope;
+        Filter    _filter;
+    };
+} // namespace klangwellen
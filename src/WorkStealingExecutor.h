@@ -0,0 +1,361 @@
+/*
+ * KlangWellen
+ *
+ * This file is part of the *KlangWellen* library (https://github.com/dennisppaul/klangwellen).
+ * Copyright (c) 2025 Dennis P Paul
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifndef KLANGWELLEN_WORK_STEALING_EXECUTOR_MAX_WORKERS
+#define KLANGWELLEN_WORK_STEALING_EXECUTOR_MAX_WORKERS 16
+#endif
+
+namespace klangwellen {
+    /**
+     * runs independent tasks of one block ( e.g voices, effect buses or independent `ProcessorGraph`s ) on a pool of
+     * worker threads and returns once all tasks are done:
+     * <pre>
+     * <code>
+     *     WorkStealingExecutor mExecutor(3);
+     *     mExecutor.set_deadline(128, 48000);
+     *     mExecutor.start();
+     *     // audio thread
+     *     mExecutor.process(mVoices, mVoiceBuffers, NUMBER_OF_VOICES, mOutput, 128);
+     * </code>
+     * </pre>
+     * the tasks are split into one contiguous range per thread. each thread processes its own range from the front and,
+     * once it is empty, steals tasks from the back of the ranges of other threads. the calling thread takes part in
+     * processing, so tasks never wait for a worker that is not scheduled in time. the calling thread never locks or
+     * allocates, workers spin while waiting for the next block and back off to short sleeps when idle.
+     * <p>
+     * if the executor is not started ( or has no workers ) all tasks are processed on the calling thread. only one
+     * thread may call `run()` or `process()` at a time.
+     */
+    class WorkStealingExecutor {
+    public:
+        using TaskFunction = void (*)(void* data, uint32_t task);
+
+        static constexpr uint8_t MAX_WORKERS = KLANGWELLEN_WORK_STEALING_EXECUTOR_MAX_WORKERS;
+
+        /**
+         * @param number_of_workers number of worker threads in addition to the calling thread. by default one less than
+         *                          the number of hardware threads.
+         */
+        explicit WorkStealingExecutor(const uint8_t number_of_workers = default_number_of_workers()) : _number_of_workers(std::min(number_of_workers, MAX_WORKERS)) {}
+
+        ~WorkStealingExecutor() {
+            stop();
+        }
+
+        WorkStealingExecutor(const WorkStealingExecutor&)            = delete;
+        WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+        static uint8_t default_number_of_workers() {
+            const uint32_t mHardwareThreads = std::thread::hardware_concurrency();
+            return static_cast<uint8_t>(std::min(mHardwareThreads > 1 ? mHardwareThreads - 1 : 0, static_cast<uint32_t>(MAX_WORKERS)));
+        }
+
+        void start() {
+            if (_running.exchange(true)) {
+                return;
+            }
+            for (uint8_t i = 0; i < _number_of_workers; i++) {
+                _workers[i] = std::thread(&WorkStealingExecutor::work, this, static_cast<uint8_t>(i + 1));
+            }
+        }
+
+        void stop() {
+            if (!_running.exchange(false)) {
+                return;
+            }
+            for (uint8_t i = 0; i < _number_of_workers; i++) {
+                if (_workers[i].joinable()) {
+                    _workers[i].join();
+                }
+            }
+        }
+
+        bool is_running() const {
+            return _running.load();
+        }
+
+        uint8_t get_number_of_workers() const {
+            return _number_of_workers;
+        }
+
+        /**
+         * pins worker `i` to CPU `first_cpu + i` ( wrapping around the number of hardware threads ). the calling thread
+         * is not pinned. must be called after `start()`.
+         *
+         * @return false if pinning is not supported on this platform or failed
+         */
+        bool pin_workers(const uint32_t first_cpu = 1) {
+#if defined(__linux__)
+            const uint32_t mHardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+            bool           mSuccess         = is_running();
+            for (uint8_t i = 0; i < _number_of_workers && mSuccess; i++) {
+                cpu_set_t mCPUs;
+                CPU_ZERO(&mCPUs);
+                CPU_SET((first_cpu + i) % mHardwareThreads, &mCPUs);
+                mSuccess = pthread_setaffinity_np(_workers[i].native_handle(), sizeof(cpu_set_t), &mCPUs) == 0;
+            }
+            return mSuccess;
+#else
+            (void) first_cpu;
+            return false;
+#endif
+        }
+
+        /**
+         * sets the time available to process one block. `run()` and `process()` measure their duration against it.
+         */
+        void set_deadline(const float seconds) {
+            _deadline = seconds;
+        }
+
+        void set_deadline(const uint32_t block_length, const uint32_t sample_rate) {
+            set_deadline(static_cast<float>(block_length) / static_cast<float>(sample_rate));
+        }
+
+        float get_deadline() const {
+            return _deadline;
+        }
+
+        /**
+         * @return duration of the last block in seconds. may be called from any thread.
+         */
+        float get_duration() const {
+            return _duration.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @return duration of the last block relative to the deadline ( i.e 1.0 means the deadline was just met ). may be
+         * called from any thread.
+         */
+        float get_load() const {
+            return _deadline > 0.0f ? get_duration() / _deadline : 0.0f;
+        }
+
+        /**
+         * @return longest duration of a block in seconds since the last `reset_statistics()`. may be called from any
+         * thread.
+         */
+        float get_max_duration() const {
+            return _max_duration.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @return number of blocks that took longer than the deadline since the last `reset_statistics()`. may be called
+         * from any thread.
+         */
+        uint32_t get_number_of_missed_deadlines() const {
+            return _missed_deadlines.load(std::memory_order_relaxed);
+        }
+
+        void reset_statistics() {
+            _max_duration.store(0.0f, std::memory_order_relaxed);
+            _missed_deadlines.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * calls `function(data, task)` for every task in `[0, number_of_tasks)` and returns once all tasks are done.
+         */
+        void run(const uint32_t number_of_tasks, const TaskFunction function, void* data) {
+            const auto mStart = std::chrono::steady_clock::now();
+            if (!is_running() || _number_of_workers == 0 || number_of_tasks < 2) {
+                for (uint32_t i = 0; i < number_of_tasks; i++) {
+                    function(data, i);
+                }
+            } else {
+                for (uint32_t i = 0; i < number_of_tasks; i += MAX_TASKS_PER_RUN) {
+                    run_parallel(i, std::min(number_of_tasks - i, MAX_TASKS_PER_RUN), function, data);
+                }
+            }
+            update_statistics(std::chrono::duration<float>(std::chrono::steady_clock::now() - mStart).count());
+        }
+
+        /**
+         * calls `function(task)` for every task in `[0, number_of_tasks)` and returns once all tasks are done.
+         */
+        template<typename FUNCTION>
+        void run(const uint32_t number_of_tasks, FUNCTION& function) {
+            run(number_of_tasks, &call_function<FUNCTION>, &function);
+        }
+
+        /**
+         * processes each processor into its own buffer ( i.e `processors[i].process(buffers[i], length)` ).
+         */
+        template<typename PROCESSOR>
+        void process(PROCESSOR* processors, float** buffers, const uint32_t number_of_processors, const uint32_t length) {
+            auto mTask = [&](const uint32_t i) {
+                processors[i].process(buffers[i], length);
+            };
+            run(number_of_processors, mTask);
+        }
+
+        /**
+         * processes each processor into its own buffer and then sums all buffers into `output`.
+         */
+        template<typename PROCESSOR>
+        void process(PROCESSOR*     processors,
+                     float**        buffers,
+                     const uint32_t number_of_processors,
+                     float*         output,
+                     const uint32_t length) {
+            process(processors, buffers, number_of_processors, length);
+            std::fill_n(output, length, 0.0f);
+            for (uint32_t j = 0; j < number_of_processors; j++) {
+                for (uint32_t i = 0; i < length; i++) {
+                    output[i] += buffers[j][i];
+                }
+            }
+        }
+
+    private:
+        static constexpr uint32_t MAX_TASKS_PER_RUN = 0xFFFF;
+        static constexpr uint32_t SPIN_COUNT        = 4096;
+
+        /* range of tasks of a thread packed as `epoch << 32 | begin << 16 | end`. the epoch keeps threads that wake up
+         * late from taking tasks of a later block. */
+        struct alignas(64) Range {
+            std::atomic<uint64_t> tasks{0};
+        };
+
+        const uint8_t         _number_of_workers;
+        std::thread           _workers[MAX_WORKERS];
+        Range                 _ranges[MAX_WORKERS + 1];
+        std::atomic<bool>     _running{false};
+        std::atomic<uint32_t> _epoch{0};
+        std::atomic<uint32_t> _completed{0};
+        TaskFunction          _function = nullptr;
+        void*                 _data     = nullptr;
+        uint32_t              _offset   = 0;
+        float                 _deadline = 0.0f;
+        std::atomic<float>    _duration{0.0f};
+        std::atomic<float>    _max_duration{0.0f};
+        std::atomic<uint32_t> _missed_deadlines{0};
+
+        template<typename FUNCTION>
+        static void call_function(void* function, const uint32_t task) {
+            (*static_cast<FUNCTION*>(function))(task);
+        }
+
+        static uint64_t pack(const uint32_t epoch, const uint32_t begin, const uint32_t end) {
+            return static_cast<uint64_t>(epoch) << 32 | static_cast<uint64_t>(begin) << 16 | end;
+        }
+
+        static uint32_t epoch_of(const uint64_t tasks) { return static_cast<uint32_t>(tasks >> 32); }
+        static uint32_t begin_of(const uint64_t tasks) { return static_cast<uint32_t>(tasks >> 16) & 0xFFFF; }
+        static uint32_t end_of(const uint64_t tasks) { return static_cast<uint32_t>(tasks) & 0xFFFF; }
+
+        void run_parallel(const uint32_t offset, const uint32_t number_of_tasks, const TaskFunction function, void* data) {
+            const uint32_t mEpoch           = _epoch.load(std::memory_order_relaxed) + 1;
+            const uint32_t mNumberOfThreads = _number_of_workers + 1;
+            _function                       = function;
+            _data                           = data;
+            _offset                         = offset;
+            _completed.store(0, std::memory_order_relaxed);
+            for (uint32_t i = 0; i < mNumberOfThreads; i++) {
+                const uint32_t mBegin = number_of_tasks * i / mNumberOfThreads;
+                const uint32_t mEnd   = number_of_tasks * (i + 1) / mNumberOfThreads;
+                _ranges[i].tasks.store(pack(mEpoch, mBegin, mEnd), std::memory_order_release);
+            }
+            _epoch.store(mEpoch, std::memory_order_release);
+
+            process_tasks(0, mEpoch);
+            while (_completed.load(std::memory_order_acquire) < number_of_tasks) {
+                process_tasks(0, mEpoch);
+            }
+        }
+
+        /* processes tasks of the own range from the front, then steals from the back of other ranges */
+        void process_tasks(const uint8_t thread, const uint32_t epoch) {
+            const uint32_t mNumberOfThreads = _number_of_workers + 1;
+            uint32_t       mTask;
+            while (take_task(_ranges[thread], epoch, true, mTask)) {
+                execute(mTask);
+            }
+            for (uint32_t i = 1; i < mNumberOfThreads; i++) {
+                Range& mVictim = _ranges[(thread + i) % mNumberOfThreads];
+                while (take_task(mVictim, epoch, false, mTask)) {
+                    execute(mTask);
+                }
+            }
+        }
+
+        static bool take_task(Range& range, const uint32_t epoch, const bool front, uint32_t& task) {
+            uint64_t mTasks = range.tasks.load(std::memory_order_acquire);
+            while (true) {
+                const uint32_t mBegin = begin_of(mTasks);
+                const uint32_t mEnd   = end_of(mTasks);
+                if (epoch_of(mTasks) != epoch || mBegin >= mEnd) {
+                    return false;
+                }
+                const uint64_t mRemaining = front ? pack(epoch, mBegin + 1, mEnd) : pack(epoch, mBegin, mEnd - 1);
+                if (range.tasks.compare_exchange_weak(mTasks, mRemaining, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    task = front ? mBegin : mEnd - 1;
+                    return true;
+                }
+            }
+        }
+
+        void execute(const uint32_t task) {
+            _function(_data, _offset + task);
+            _completed.fetch_add(1, std::memory_order_release);
+        }
+
+        void work(const uint8_t thread) {
+            uint32_t mEpoch     = _epoch.load(std::memory_order_acquire);
+            uint32_t mIdleCount = 0;
+            while (_running.load(std::memory_order_relaxed)) {
+                const uint32_t mNextEpoch = _epoch.load(std::memory_order_acquire);
+                if (mNextEpoch != mEpoch) {
+                    mEpoch     = mNextEpoch;
+                    mIdleCount = 0;
+                    process_tasks(thread, mEpoch);
+                } else if (mIdleCount < SPIN_COUNT) {
+                    mIdleCount++;
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            }
+        }
+
+        void update_statistics(const float duration) {
+            _duration.store(duration, std::memory_order_relaxed);
+            if (duration > _max_duration.load(std::memory_order_relaxed)) {
+                _max_duration.store(duration, std::memory_order_relaxed);
+            }
+            if (_deadline > 0.0f && duration > _deadline) {
+                _missed_deadlines.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+} // namespace klangwellen